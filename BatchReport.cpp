@@ -0,0 +1,229 @@
+#include "BatchReport.h"
+#include "WindTempSolar.h"
+#include "Time.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace {
+// Parses a whole string as a non-negative integer
+bool parseNumber(const std::string& text, int& value) {
+    if (text.empty() || text.size() > 9 || text.find_first_not_of("0123456789") != std::string::npos) return false;
+    value = std::atoi(text.c_str());
+    return true;
+}
+
+// Parses "M/YYYY" into a month and year
+bool parseMonthYear(const std::string& text, int& month, int& year) {
+    size_t slash = text.find('/');
+    if (slash == std::string::npos) return false;
+    return parseNumber(text.substr(0, slash), month) && parseNumber(text.substr(slash + 1), year)
+        && month >= 1 && month <= 12;
+}
+
+// Parses "D/M/YYYY" into a day, month and year, checking that the day exists
+bool parseDayMonthYear(const std::string& text, int& day, int& month, int& year) {
+    size_t slash = text.find('/');
+    if (slash == std::string::npos || !parseNumber(text.substr(0, slash), day)) return false;
+    if (!parseMonthYear(text.substr(slash + 1), month, year) || day < 1) return false;
+    long long first = Date(1, month, year).toDayNumber();
+    long long next = (month == 12) ? Date(1, 1, year + 1).toDayNumber() : Date(1, month + 1, year).toDayNumber();
+    return day <= next - first;
+}
+
+// Returns true if any date of a period names a month outside 1..12
+bool hasInvalidMonth(const std::string& period) {
+    size_t colon = period.find(':');
+    std::istringstream pieces(colon == std::string::npos ? period : period.substr(colon + 1));
+    std::string piece;
+    while (std::getline(pieces, piece, '-')) {
+        size_t last = piece.rfind('/');
+        if (last == std::string::npos) continue;
+        size_t first = piece.rfind('/', last - 1);
+        first = (last == 0 || first == std::string::npos) ? 0 : first + 1;
+        int month;
+        if (parseNumber(piece.substr(first, last - first), month) && (month < 1 || month > 12)) return true;
+    }
+    return false;
+}
+
+// Maps a metric name to its QuerySpec metric and percentile
+bool parseMetric(const std::string& name, QuerySpec::Metric& metric, float& percentile) {
+    percentile = 50;
+    if (name == "mean") metric = QuerySpec::MEAN;
+    else if (name == "stdev") metric = QuerySpec::STANDARD_DEVIATION;
+    else if (name == "mad") metric = QuerySpec::MEAN_ABSOLUTE_DEVIATION;
+    else if (name == "total") metric = QuerySpec::TOTAL;
+    else if (name == "min") metric = QuerySpec::MIN;
+    else if (name == "max") metric = QuerySpec::MAX;
+    else if (name == "count") metric = QuerySpec::COUNT;
+    else if (name == "correlation") metric = QuerySpec::CORRELATION;
+    else if (name == "medianad") metric = QuerySpec::MEDIAN_ABSOLUTE_DEVIATION;
+    else if (name == "coverage") metric = QuerySpec::COVERAGE;
+    else if (name == "missing") metric = QuerySpec::MISSING;
+    else if (name == "gaps") metric = QuerySpec::GAPS;
+    else if (name == "duplicates") metric = QuerySpec::DUPLICATES;
+    else {
+        int value;
+        if (name.size() > 1 && name[0] == 'p' && parseNumber(name.substr(1), value) && value <= 100) {
+            metric = QuerySpec::PERCENTILE;
+        } else if (name.size() > 6 && name.compare(0, 6, "approx") == 0 && parseNumber(name.substr(6), value) && value <= 100) {
+            metric = QuerySpec::APPROXIMATE_PERCENTILE;
+        } else {
+            return false;
+        }
+        percentile = (float)value;
+    }
+    return true;
+}
+}
+
+// Parses a report line and expands its period into queries
+bool BatchReport::addReport(const std::string& spec, std::string& error) {
+    std::istringstream words(spec);
+    std::vector<std::string> parts;
+    std::string word;
+    while (words >> word) parts.push_back(word);
+
+    QuerySpec::Metric metric;
+    float percentile;
+    if (parts.empty() || !parseMetric(parts[0], metric, percentile)) {
+        error = "unknown metric in report \"" + spec + "\"";
+        return false;
+    }
+    size_t expected = (metric == QuerySpec::CORRELATION) ? 4 : 3;
+    if (parts.size() != expected) {
+        error = "expected \"<metric> <field>" + std::string(expected == 4 ? " <field2>" : "") + " <period>\" in report \"" + spec + "\"";
+        return false;
+    }
+    std::string field = parts[1];
+    std::string field2 = (expected == 4) ? parts[2] : "";
+    if (WindTempSolar::getFieldIndex(field) < 0 || (expected == 4 && WindTempSolar::getFieldIndex(field2) < 0)) {
+        error = "unknown field in report \"" + spec + "\"";
+        return false;
+    }
+
+    // Expand the period into (label, query) pairs
+    const std::string& period = parts.back();
+    std::vector<QuerySpec> expanded;
+    std::vector<std::string> labels;
+    int day, month, year, endMonth, endYear;
+    size_t dash = period.find('-');
+    const long long minutesPerDay = 24 * 60;
+    bool hourly = period.compare(0, 7, "hourly:") == 0;
+    bool daily = period.compare(0, 6, "daily:") == 0;
+    if ((hourly || daily) && metric != QuerySpec::MEAN && metric != QuerySpec::TOTAL && metric != QuerySpec::COUNT) {
+        error = "hourly and daily periods support mean, total and count only, in report \"" + spec + "\"";
+        return false;
+    }
+    if (hourly && parseDayMonthYear(period.substr(7), day, month, year)) {
+        Date date(day, month, year);
+        long long start = date.toDayNumber() * minutesPerDay;
+        for (int hour = 0; hour < 24; ++hour) {
+            expanded.push_back(QuerySpec::window(metric, field, start + hour * 60, start + (hour + 1) * 60));
+            labels.push_back(date.toString() + " " + Time(hour, 0).toString());
+        }
+    } else if (daily && parseMonthYear(period.substr(6), month, year)) {
+        long long first = Date(1, month, year).toDayNumber();
+        long long next = (month == 12) ? Date(1, 1, year + 1).toDayNumber() : Date(1, month + 1, year).toDayNumber();
+        for (long long d = first; d < next; ++d) {
+            expanded.push_back(QuerySpec::window(metric, field, d * minutesPerDay, (d + 1) * minutesPerDay));
+            labels.push_back(Date::fromDayNumber(d).toString());
+        }
+    } else if (dash != std::string::npos && parseMonthYear(period.substr(0, dash), month, year)
+        && parseMonthYear(period.substr(dash + 1), endMonth, endYear)) {
+        if (endYear * 12 + endMonth < year * 12 + month) {
+            error = "range \"" + period + "\" ends before it starts in report \"" + spec + "\"";
+            return false;
+        }
+        expanded.push_back(QuerySpec::range(metric, field, month, year, endMonth, endYear, field2));
+        labels.push_back(period);
+    } else if (dash != std::string::npos && parseNumber(period.substr(0, dash), year)
+        && parseNumber(period.substr(dash + 1), endYear)) {
+        if (endYear < year) {
+            error = "range \"" + period + "\" ends before it starts in report \"" + spec + "\"";
+            return false;
+        }
+        for (int y = year; y <= endYear; ++y) {
+            for (int m = 1; m <= 12; ++m) {
+                expanded.push_back(QuerySpec(metric, field, m, y, field2));
+                labels.push_back(std::to_string(m) + "/" + std::to_string(y));
+            }
+        }
+    } else if (parseMonthYear(period, month, year)) {
+        expanded.push_back(QuerySpec(metric, field, month, year, field2));
+        labels.push_back(period);
+    } else if (parseNumber(period, month) && month >= 1 && month <= 12) {
+        expanded.push_back(QuerySpec(metric, field, month, 0, field2));
+        labels.push_back(period);
+    } else if (parseNumber(period, year) && year > 12) {
+        for (int m = 1; m <= 12; ++m) {
+            expanded.push_back(QuerySpec(metric, field, m, year, field2));
+            labels.push_back(std::to_string(m) + "/" + std::to_string(year));
+        }
+    } else if (hasInvalidMonth(period)) {
+        error = "month out of range 1-12 in period \"" + period + "\" of report \"" + spec + "\"";
+        return false;
+    } else {
+        error = "invalid period \"" + period + "\" in report \"" + spec + "\"";
+        return false;
+    }
+
+    for (size_t i = 0; i < expanded.size(); ++i) {
+        queries.push_back(expanded[i].withPercentile(percentile));
+        metrics.push_back(parts[0]);
+        periods.push_back(labels[i]);
+    }
+    return true;
+}
+
+// Adds every report line of a query file
+bool BatchReport::loadFile(const std::string& filename, std::string& error) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        error = "unable to open query file " + filename;
+        return false;
+    }
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue;
+        if (!addReport(line, error)) {
+            error = filename + ":" + std::to_string(lineNumber) + ": " + error;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns the queries of all reports
+const std::vector<QuerySpec>& BatchReport::getQueries() const {
+    return queries;
+}
+
+// Checks whether any report has been added
+bool BatchReport::empty() const {
+    return queries.empty();
+}
+
+// Writes one row per query
+void BatchReport::write(ReportWriter& writer, const std::vector<float>& results, const std::string& station) const {
+    std::vector<std::string> columns;
+    columns.push_back("station");
+    columns.push_back("period");
+    columns.push_back("metric");
+    columns.push_back("field");
+    columns.push_back("value");
+    writer.setColumns(columns);
+    for (size_t i = 0; i < queries.size() && i < results.size(); ++i) {
+        writer.beginRow();
+        writer.addText(station);
+        writer.addText(periods[i]);
+        writer.addText(metrics[i]);
+        writer.addText(queries[i].field2.empty() ? queries[i].field : queries[i].field + ":" + queries[i].field2);
+        writer.addFloat(results[i]);
+        writer.endRow();
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef BATCHREPORT_H
+#define BATCHREPORT_H
+
+#include "QuerySpec.h"
+#include "ReportWriter.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief A list of reports to produce non-interactively, planned as one query batch.
+ *
+ * Each report is a line of the form "<metric> <field> [<field2>] <period>", for example
+ * "mean wind_speed 2015" or "correlation wind_speed temperature 6". Metrics are mean,
+ * stdev, mad, total, min, max, count, correlation, medianad, pNN (exact percentile),
+ * approxNN (approximate percentile) and the data quality metrics coverage (percentage of
+ * expected samples with a valid value), missing (invalid values), gaps (samples missing in
+ * timestamp gaps) and duplicates; gaps and duplicates do not depend on the field, but one is
+ * still given. The period is one of:
+ * - M/YYYY for one month,
+ * - YYYY for each month of a year,
+ * - YYYY-YYYY for each month of a range of years,
+ * - M for one month across all years,
+ * - M/YYYY-M/YYYY for a single range of months,
+ * - hourly:D/M/YYYY for each hour of a day,
+ * - daily:M/YYYY for each day of a month.
+ *
+ * Months must be 1 to 12, and ranges must not end before they start.
+ *
+ * Hourly and daily periods support mean, total and count, answered from the resampled series.
+ *
+ * All reports are expanded into QuerySpec objects up front, so they can be evaluated with a
+ * single call to evaluateBatch and share one scan of the data.
+ */
+class BatchReport {
+public:
+    /**
+     * @brief Parses a report and adds its queries.
+     *
+     * @param spec The report line.
+     * @param error Receives a description of the problem if the report is invalid.
+     * @return true if the report was added, false if it is invalid.
+     */
+    bool addReport(const std::string& spec, std::string& error);
+
+    /**
+     * @brief Adds every report of a query file, one per line.
+     *
+     * Blank lines and lines starting with '#' are ignored.
+     *
+     * @param filename The name of the query file.
+     * @param error Receives a description of the first problem found.
+     * @return true if the whole file was read, false otherwise.
+     */
+    bool loadFile(const std::string& filename, std::string& error);
+
+    /**
+     * @brief Returns the queries of all reports, in report order.
+     *
+     * @return The queries.
+     */
+    const std::vector<QuerySpec>& getQueries() const;
+
+    /**
+     * @brief Checks whether any report has been added.
+     *
+     * @return true if there are no queries, false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Writes the results with one row per query.
+     *
+     * The columns are station, period, metric, field and value.
+     *
+     * @param writer The writer, which determines the output format.
+     * @param results The results of getQueries(), in the same order.
+     * @param station The name of the station the results belong to.
+     */
+    void write(ReportWriter& writer, const std::vector<float>& results, const std::string& station) const;
+
+private:
+    std::vector<QuerySpec> queries;     /**< Queries of all reports. */
+    std::vector<std::string> metrics;   /**< Metric name of each query as written in its report. */
+    std::vector<std::string> periods;   /**< Period label of each query. */
+};
+
+#endif // BATCHREPORT_H
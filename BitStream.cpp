@@ -0,0 +1,63 @@
+#include "BitStream.h"
+
+// Constructor creates a writer appending to the buffer
+BitWriter::BitWriter(std::vector<unsigned char>& buffer) : buffer(buffer), freeBits(0) {}
+
+// Writes the lowest bitCount bits of the value, filling the last byte first
+void BitWriter::write(uint64_t value, int bitCount) {
+    while (bitCount > 0) {
+        if (freeBits == 0) {
+            buffer.push_back(0);
+            freeBits = 8;
+        }
+        int chunk = (bitCount < freeBits) ? bitCount : freeBits;
+        unsigned char bits = (unsigned char)((value >> (bitCount - chunk)) & ((1u << chunk) - 1));
+        buffer.back() |= (unsigned char)(bits << (freeBits - chunk));
+        freeBits -= chunk;
+        bitCount -= chunk;
+    }
+}
+
+// Writes a zigzag-encoded value in 7-bit groups, each preceded by a continuation bit
+void BitWriter::writeSigned(int64_t value) {
+    uint64_t zigzag = ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+    do {
+        uint64_t group = zigzag & 0x7F;
+        zigzag >>= 7;
+        write(zigzag != 0 ? 1 : 0, 1);
+        write(group, 7);
+    } while (zigzag != 0);
+}
+
+// Constructor creates a reader over the buffer
+BitReader::BitReader(const unsigned char* data, size_t size) : data(data), size(size), position(0) {}
+
+// Reads bitCount bits as an unsigned value
+uint64_t BitReader::read(int bitCount) {
+    uint64_t value = 0;
+    while (bitCount > 0) {
+        size_t byte = position / 8;
+        int offset = (int)(position % 8);
+        int available = 8 - offset;
+        int chunk = (bitCount < available) ? bitCount : available;
+        unsigned int current = (byte < size) ? data[byte] : 0;
+        unsigned int bits = (current >> (available - chunk)) & ((1u << chunk) - 1);
+        value = (value << chunk) | bits;
+        position += chunk;
+        bitCount -= chunk;
+    }
+    return value;
+}
+
+// Reads a zigzag-encoded value written in 7-bit groups
+int64_t BitReader::readSigned() {
+    uint64_t zigzag = 0;
+    int shift = 0;
+    bool more = true;
+    while (more && shift < 64) {
+        more = read(1) != 0;
+        zigzag |= read(7) << shift;
+        shift += 7;
+    }
+    return (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+}
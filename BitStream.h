@@ -0,0 +1,78 @@
+#ifndef BITSTREAM_H
+#define BITSTREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Appends values of arbitrary bit width to a byte buffer, most significant bit first.
+ */
+class BitWriter {
+public:
+    /**
+     * @brief Constructs a writer that appends to the given buffer.
+     *
+     * @param buffer The buffer receiving the bits.
+     */
+    BitWriter(std::vector<unsigned char>& buffer);
+
+    /**
+     * @brief Writes the lowest bits of a value.
+     *
+     * @param value The value to write.
+     * @param bitCount The number of bits to write (0-64).
+     */
+    void write(uint64_t value, int bitCount);
+
+    /**
+     * @brief Writes a signed value as a variable-length group of 7-bit chunks.
+     *
+     * Small magnitudes take few bits; the sign is folded in with zigzag encoding.
+     *
+     * @param value The value to write.
+     */
+    void writeSigned(int64_t value);
+
+private:
+    std::vector<unsigned char>& buffer; /**< Buffer receiving the bits. */
+    int freeBits;                       /**< Unused bits in the last byte of the buffer. */
+};
+
+/**
+ * @brief Reads values written by a BitWriter.
+ */
+class BitReader {
+public:
+    /**
+     * @brief Constructs a reader over a byte buffer.
+     *
+     * @param data Pointer to the first byte.
+     * @param size The number of bytes.
+     */
+    BitReader(const unsigned char* data, size_t size);
+
+    /**
+     * @brief Reads a value of the given bit width.
+     *
+     * Reading past the end of the buffer yields zero bits.
+     *
+     * @param bitCount The number of bits to read (0-64).
+     * @return The value.
+     */
+    uint64_t read(int bitCount);
+
+    /**
+     * @brief Reads a value written by BitWriter::writeSigned.
+     *
+     * @return The value.
+     */
+    int64_t readSigned();
+
+private:
+    const unsigned char* data;  /**< Buffer being read. */
+    size_t size;                /**< Size of the buffer in bytes. */
+    size_t position;            /**< Position of the next bit. */
+};
+
+#endif // BITSTREAM_H
@@ -1,41 +1,532 @@
-#include "CalcResults.h"
-#include "Math.h"
-
-// Constructor for CalcResults, initializes the object with data from the provided vector, BST, and map.
-CalcResults::CalcResults(const Vector<WindTempSolar>& data, const Bst<WindTempSolar>& bstData, const std::map<std::string, WindTempSolar>& dataMap)
-    : data(data), bstData(bstData), dataMap(dataMap) {}
-
-// Calculates and returns the average wind speed for the specified month and year.
-float CalcResults::calculateAverageWindSpeed(int month, int year) const {
-    return Math::calculateAverageWindSpeed(data, month, year);
-}
-
-// Calculates and returns the standard deviation of wind speed for the specified month and year.
-float CalcResults::calculateStandardDeviation(int month, int year) const {
-    return Math::calculateStandardDeviation(data, month, year);
-}
-
-// Calculates and returns the average ambient air temperature for the specified month and year.
-float CalcResults::calculateAverageAmbientTemperature(int month, int year) const {
-    return Math::calculateAverageAmbientTemperature(data, month, year);
-}
-
-// Calculates and returns the total solar radiation for the specified month and year.
-float CalcResults::calculateTotalSolarRadiation(int month, int year) const {
-    return Math::calculateTotalSolarRadiation(data, month, year);
-}
-
-// Calculates and returns the mean absolute deviation of wind speed for the specified month and year.
-float CalcResults::calculateWindSpeedMAD(int month, int year) const {
-    return Math::calculateWindSpeedMAD(data, month, year);
-}
-
-// Calculates and returns the mean absolute deviation of temperature for the specified month and year.
-float CalcResults::calculateTemperatureMAD(int month, int year) const {
-    return Math::calculateTemperatureMAD(data, month, year);
-}
-
-// Calculates and returns the sample Pearson correlation coefficient (SPCC) between two fields for the specified month.
-float CalcResults::calculateSPCC(int month, const std::string& field1, const std::string& field2) const {
-    return Math::calculateSPCC(data, month, field1, field2);
-}
+#include "CalcResults.h"
+#include "Math.h"
+#include "Percentile.h"
+#include "Profiler.h"
+#include <cmath>
+
+namespace {
+const int WORD_BITS = ValidityMask::WORD_BITS;
+static_assert(ZoneMap::BLOCK_SIZE % ValidityMask::WORD_BITS == 0, "zone map blocks must be whole bitmap words");
+
+// Returns the first day of the month after the given month
+Date nextMonth(const Date& month) {
+    return (month.getMonth() == 12) ? Date(1, 1, month.getYear() + 1) : Date(1, month.getMonth() + 1, month.getYear());
+}
+
+// The dates and values of a word of 64 consecutive records, the unit of the masked scans: a
+// period filter over the dates is ANDed with a word of a field's validity bitmap, so invalid
+// values are dropped by bitwise operations rather than a NaN test per record
+struct RecordWord {
+    size_t index;                                           // Index of the word in the validity bitmaps
+    int count;                                              // Records in the word (64 except at the end of the data)
+    Date dates[WORD_BITS];
+    float values[WindTempSolar::FIELD_COUNT][WORD_BITS];
+
+    void load(const Vector<WindTempSolar>& data, int base, int end) {
+        index = (size_t)base / WORD_BITS;
+        count = (end - base < WORD_BITS) ? end - base : WORD_BITS;
+        for (int j = 0; j < count; ++j) {
+            const WindTempSolar& record = data[base + j];
+            dates[j] = record.getDate();
+            for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) values[f][j] = record.getValue(f);
+        }
+    }
+
+    // Returns the bits of the records whose date lies in the period of a query
+    uint64_t periodBits(const QuerySpec& query) const {
+        uint64_t bits = 0;
+        for (int j = 0; j < count; ++j) bits |= (uint64_t)query.matches(dates[j]) << j;
+        return bits;
+    }
+
+    // Returns the sum of the absolute differences of the selected values of a field from a centre
+    double absoluteDeviations(int field, uint64_t mask, float centre) const {
+        double sum = 0;
+        for (int j = 0; j < count; ++j) {
+            // Unselected values (possibly NaN) are replaced by the centre with a select, not a branch
+            float value = ((mask >> j) & 1) ? values[field][j] : centre;
+            sum += std::abs(value - centre);
+        }
+        return sum;
+    }
+
+    // Appends the selected values of a field, visiting only the set bits of the mask
+    void appendSelected(int field, uint64_t mask, std::vector<float>& output) const {
+        for (; mask != 0; mask &= mask - 1) output.push_back(values[field][ValidityMask::lowestBit(mask)]);
+    }
+};
+}
+
+// Constructor for CalcResults, initializes the object with the records of the store and the summary cube.
+CalcResults::CalcResults(const RecordStore& store, const SummaryCube& cube, size_t cacheCapacity)
+    : store(store), data(store.getRecords()), cube(cube), cache(cacheCapacity), seriesGeneration(0) {}
+
+// Calculates and returns the average wind speed for the specified month and year.
+float CalcResults::calculateAverageWindSpeed(int month, int year) const {
+    return evaluateBatch(std::vector<QuerySpec>(1, QuerySpec(QuerySpec::MEAN, "wind_speed", month, year)))[0];
+}
+
+// Calculates and returns the standard deviation of wind speed for the specified month and year.
+float CalcResults::calculateStandardDeviation(int month, int year) const {
+    return evaluateBatch(std::vector<QuerySpec>(1, QuerySpec(QuerySpec::STANDARD_DEVIATION, "wind_speed", month, year)))[0];
+}
+
+// Calculates and returns the average ambient air temperature for the specified month and year.
+float CalcResults::calculateAverageAmbientTemperature(int month, int year) const {
+    return evaluateBatch(std::vector<QuerySpec>(1, QuerySpec(QuerySpec::MEAN, "temperature", month, year)))[0];
+}
+
+// Calculates and returns the total solar radiation for the specified month and year.
+float CalcResults::calculateTotalSolarRadiation(int month, int year) const {
+    return evaluateBatch(std::vector<QuerySpec>(1, QuerySpec(QuerySpec::TOTAL, "solar_radiation", month, year)))[0];
+}
+
+// Calculates and returns the mean absolute deviation of wind speed for the specified month and year.
+float CalcResults::calculateWindSpeedMAD(int month, int year) const {
+    return evaluateBatch(std::vector<QuerySpec>(1, QuerySpec(QuerySpec::MEAN_ABSOLUTE_DEVIATION, "wind_speed", month, year)))[0];
+}
+
+// Calculates and returns the mean absolute deviation of temperature for the specified month and year.
+float CalcResults::calculateTemperatureMAD(int month, int year) const {
+    return evaluateBatch(std::vector<QuerySpec>(1, QuerySpec(QuerySpec::MEAN_ABSOLUTE_DEVIATION, "temperature", month, year)))[0];
+}
+
+// Calculates and returns the sample Pearson correlation coefficient (SPCC) between two fields for the specified month.
+float CalcResults::calculateSPCC(int month, const std::string& field1, const std::string& field2) const {
+    return evaluateBatch(std::vector<QuerySpec>(1, QuerySpec(QuerySpec::CORRELATION, field1, month, 0, field2)))[0];
+}
+
+// Calculates and returns an exact percentile of a field for the specified month and year.
+float CalcResults::calculatePercentile(const std::string& field, float percentile, int month, int year) const {
+    return evaluateBatch(std::vector<QuerySpec>(1, QuerySpec(QuerySpec::PERCENTILE, field, month, year).withPercentile(percentile)))[0];
+}
+
+// Estimates a percentile of a field for the specified month and year from the summary cube.
+float CalcResults::calculateApproximatePercentile(const std::string& field, float percentile, int month, int year) const {
+    return evaluateBatch(std::vector<QuerySpec>(1, QuerySpec(QuerySpec::APPROXIMATE_PERCENTILE, field, month, year).withPercentile(percentile)))[0];
+}
+
+// Calculates and returns the median absolute deviation of a field for the specified month and year.
+float CalcResults::calculateMedianAbsoluteDeviation(const std::string& field, int month, int year) const {
+    return evaluateBatch(std::vector<QuerySpec>(1, QuerySpec(QuerySpec::MEDIAN_ABSOLUTE_DEVIATION, field, month, year)))[0];
+}
+
+// Returns the wind speed histogram for the specified month and year.
+Histogram CalcResults::getWindSpeedHistogram(int month, int year) const {
+    return cube.getWindSpeedHistogram(month, year);
+}
+
+// Fits Weibull parameters to the wind speed histogram of the specified month and year.
+WeibullFit CalcResults::fitWindSpeedWeibull(int month, int year) const {
+    return WeibullFit::fromHistogram(cube.getWindSpeedHistogram(month, year));
+}
+
+// Calculates rolling statistics of a field over the time-ordered data.
+std::vector<std::vector<RollingPoint> > CalcResults::calculateRollingStatistics(const std::string& field, const std::vector<long long>& durations) const {
+    PROFILE_SCOPE("CalcResults::calculateRollingStatistics");
+    return RollingStatistics::calculate(store, field, durations);
+}
+
+// Returns the data resampled into fixed buckets, building the series on first use.
+const SeriesStore& CalcResults::getSeries(long long bucketMinutes) const {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    if (seriesGeneration != cube.getGeneration()) {
+        seriesCache.clear();
+        seriesGeneration = cube.getGeneration();
+    }
+    std::map<long long, SeriesStore>::iterator it = seriesCache.find(bucketMinutes);
+    if (it == seriesCache.end()) {
+        PROFILE_SCOPE("CalcResults::getSeries resample");
+        it = seriesCache.insert(std::make_pair(bucketMinutes, Resampler::resample(data, bucketMinutes))).first;
+    }
+    return it->second;
+}
+
+// Calculates and returns the average of a field over a time window.
+float CalcResults::calculateAverageInWindow(const std::string& field, long long start, long long end) const {
+    PROFILE_SCOPE("CalcResults::calculateAverageInWindow");
+    refreshZoneMap();
+    return Math::calculateAverage(store, zoneMap, field, start, end);
+}
+
+// Counts the records in a time window whose field lies in the value range.
+long long CalcResults::countRecordsInRange(const std::string& field, float minValue, float maxValue, long long start, long long end) const {
+    PROFILE_SCOPE("CalcResults::countRecordsInRange");
+    refreshZoneMap();
+    return Math::countRecords(data, zoneMap, field, minValue, maxValue, start, end);
+}
+
+// Evaluates a range query, merging whole months from the cube and scanning only the partial months at the ends.
+std::vector<GroupResult> CalcResults::evaluateRange(const RangeQuery& query) const {
+    PROFILE_SCOPE("CalcResults::evaluateRange");
+    const long long minutesPerDay = 24 * 60;
+    std::map<long long, GroupResult> groups;
+    if (query.end <= query.start) return std::vector<GroupResult>();
+
+    // Whole months are those lying entirely inside [start, end)
+    Date startDate = Date::fromDayNumber(query.start / minutesPerDay);
+    Date lastDate = Date::fromDayNumber((query.end - 1) / minutesPerDay);
+    Date firstMonth(1, startDate.getMonth(), startDate.getYear());
+    if (firstMonth.toDayNumber() * minutesPerDay < query.start) firstMonth = nextMonth(firstMonth);
+    Date endMonth(1, lastDate.getMonth(), lastDate.getYear());
+    if (nextMonth(endMonth).toDayNumber() * minutesPerDay == query.end) endMonth = nextMonth(endMonth);
+    long long wholeStart = firstMonth.toDayNumber() * minutesPerDay;
+    long long wholeEnd = endMonth.toDayNumber() * minutesPerDay;
+
+    // Whole months come straight from the cube
+    if (wholeStart < wholeEnd) {
+        Date lastMonth = Date::fromDayNumber(endMonth.toDayNumber() - 1);
+        std::vector<std::pair<Date, const MonthlySummary*> > months = cube.getSummaries(firstMonth.getMonth(), firstMonth.getYear(), lastMonth.getMonth(), lastMonth.getYear());
+        for (size_t i = 0; i < months.size(); ++i) {
+            long long key = query.getGroupKey(months[i].first);
+            GroupResult& group = groups[key];
+            if (group.label.empty()) {
+                group.key = key;
+                group.label = query.getGroupLabel(months[i].first);
+            }
+            group.summary.merge(*months[i].second);
+        }
+    } else {
+        wholeStart = wholeEnd = query.end;
+    }
+
+    // Partial months are read in time order through the timestamp index, so their gaps and
+    // duplicates are counted as the cube counts them: a repeated timestamp is a duplicate, and a
+    // step longer than the sampling interval a gap before the later record
+    long long scanStarts[2] = { query.start, wholeEnd };
+    long long scanEnds[2] = { wholeStart, query.end };
+    long long interval = cube.getSampleMinutes();
+    for (int part = 0; part < 2; ++part) {
+        if (scanStarts[part] >= scanEnds[part]) continue;
+        const std::vector<RecordStore::RecordId>& index = store.getTimestampIndex();
+        std::pair<size_t, size_t> range = store.findTimeRange(scanStarts[part], scanEnds[part]);
+        for (size_t p = range.first; p < range.second; ++p) {
+            const WindTempSolar& record = data[(int)index[p]];
+            Date date = record.getDate();
+            long long key = query.getGroupKey(date);
+            GroupResult& group = groups[key];
+            if (group.label.empty()) {
+                group.key = key;
+                group.label = query.getGroupLabel(date);
+            }
+            group.summary.add(record);
+            if (p == 0) continue;
+            long long step = record.getTimestamp() - data[(int)index[p - 1]].getTimestamp();
+            if (step == 0) {
+                group.summary.addDuplicate();
+            } else if (interval > 0 && step > interval) {
+                group.summary.addGap((step - 1) / interval);
+            }
+        }
+    }
+
+    std::vector<GroupResult> results;
+    for (std::map<long long, GroupResult>::const_iterator it = groups.begin(); it != groups.end(); ++it) {
+        results.push_back(it->second);
+    }
+    return results;
+}
+
+// Evaluates a list of queries, sharing a single data scan between all raw-data queries.
+std::vector<float> CalcResults::evaluateBatch(const std::vector<QuerySpec>& queries) const {
+    PROFILE_SCOPE("CalcResults::evaluateBatch");
+    PROFILE_COUNT("queries evaluated", queries.size());
+    std::vector<float> results(queries.size(), 0);
+    std::vector<size_t> pending; // Queries that need a data scan
+
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const QuerySpec& query = queries[i];
+        if (query.isWindow()) {
+            results[i] = getCachedResult(query, [&]() {
+                return evaluateWindow(query, getWindowAggregate(query));
+            });
+        } else if (query.needsScan()) {
+            if (!cache.lookup(query.toKey(), cube.getGeneration(), results[i])) {
+                pending.push_back(i);
+            }
+        } else if (query.metric == QuerySpec::APPROXIMATE_PERCENTILE) {
+            results[i] = getCachedResult(query, [&]() {
+                return getDigest(query).getPercentile(query.percentile);
+            });
+        } else {
+            results[i] = getCachedResult(query, [&]() {
+                return evaluateSummary(query, getSummary(query));
+            });
+        }
+    }
+
+    if (!pending.empty()) {
+        evaluateScan(queries, pending, results);
+        for (size_t i = 0; i < pending.size(); ++i) {
+            cache.store(queries[pending[i]].toKey(), cube.getGeneration(), results[pending[i]]);
+        }
+    }
+    return results;
+}
+
+// Returns the number of queries answered from the result cache.
+unsigned long long CalcResults::getCacheHits() const {
+    return cache.getHits();
+}
+
+// Returns the number of queries that had to be computed.
+unsigned long long CalcResults::getCacheMisses() const {
+    return cache.getMisses();
+}
+
+// Returns a cached result for the query, computing and storing it on a miss.
+float CalcResults::getCachedResult(const QuerySpec& query, const std::function<float()>& compute) const {
+    std::string key = query.toKey();
+    float value;
+    if (cache.lookup(key, cube.getGeneration(), value)) {
+        return value;
+    }
+    value = compute();
+    cache.store(key, cube.getGeneration(), value);
+    return value;
+}
+
+// Returns the summary of the period covered by the query.
+MonthlySummary CalcResults::getSummary(const QuerySpec& query) const {
+    if (query.isRange()) {
+        return cube.getRangeSummary(query.month, query.year, query.endMonth, query.endYear);
+    }
+    if (query.year == 0) {
+        return cube.getMonthSummary(query.month);
+    }
+    return cube.getSummary(query.month, query.year);
+}
+
+// Computes a metric that can be answered from a summary.
+float CalcResults::evaluateSummary(const QuerySpec& query, const MonthlySummary& summary) {
+    switch (query.metric) {
+        case QuerySpec::MEAN: return summary.getMean(query.field);
+        case QuerySpec::STANDARD_DEVIATION: return summary.getStandardDeviation(query.field);
+        case QuerySpec::TOTAL: return summary.getTotal(query.field);
+        case QuerySpec::MIN: return summary.getMin(query.field);
+        case QuerySpec::MAX: return summary.getMax(query.field);
+        case QuerySpec::CORRELATION: return summary.getCorrelation(query.field, query.field2);
+        case QuerySpec::COUNT: return (float)summary.getCount();
+        case QuerySpec::COVERAGE: return summary.getCoverage(query.field);
+        case QuerySpec::MISSING: return (float)summary.getMissingCount(query.field);
+        case QuerySpec::GAPS: return (float)summary.getMissingSamples();
+        case QuerySpec::DUPLICATES: return (float)summary.getDuplicateCount();
+        default: return 0;
+    }
+}
+
+// Returns the percentile digest of the field and period of the query.
+TDigest CalcResults::getDigest(const QuerySpec& query) const {
+    if (query.isRange()) {
+        return cube.getRangeDigest(query.field, query.month, query.year, query.endMonth, query.endYear);
+    }
+    return cube.getDigest(query.field, query.month, query.year);
+}
+
+// Returns the aggregate of a window from the coarsest series whose buckets tile it
+SeriesBucket CalcResults::getWindowAggregate(const QuerySpec& query) const {
+    long long bucketMinutes = 1;
+    if (query.windowStart % Resampler::DAILY == 0 && query.windowEnd % Resampler::DAILY == 0) {
+        bucketMinutes = Resampler::DAILY;
+    } else if (query.windowStart % Resampler::HOURLY == 0 && query.windowEnd % Resampler::HOURLY == 0) {
+        bucketMinutes = Resampler::HOURLY;
+    }
+    return getSeries(bucketMinutes).getAggregate(query.windowStart, query.windowEnd);
+}
+
+// Computes a window metric from its aggregate
+float CalcResults::evaluateWindow(const QuerySpec& query, const SeriesBucket& aggregate) {
+    int f = WindTempSolar::getFieldIndex(query.field);
+    if (f < 0) return 0;
+    switch (query.metric) {
+        case QuerySpec::MEAN: return aggregate.getMean(f);
+        case QuerySpec::TOTAL: return (float)aggregate.sum[f];
+        case QuerySpec::COUNT: return (float)aggregate.count;
+        default: return 0;
+    }
+}
+
+// Collects the field values of every query's period in a single pass over the data.
+void CalcResults::collectValues(const std::vector<QuerySpec>& queries, std::vector<std::vector<float> >& values) const {
+    PROFILE_SCOPE("CalcResults::collectValues");
+    values.assign(queries.size(), std::vector<float>());
+    std::vector<int> fieldIndexes(queries.size(), -1);
+    std::vector<long long> starts(queries.size(), 0);
+    std::vector<long long> ends(queries.size(), 0);
+    std::vector<bool> bounded(queries.size(), false);
+    for (size_t q = 0; q < queries.size(); ++q) {
+        fieldIndexes[q] = WindTempSolar::getFieldIndex(queries[q].field);
+        bounded[q] = queries[q].getTimeRange(starts[q], ends[q]);
+    }
+    refreshZoneMap();
+    std::vector<size_t> active;
+    RecordWord word;
+
+    for (int b = 0; b < zoneMap.getBlockCount(); ++b) {
+        active.clear();
+        for (size_t q = 0; q < queries.size(); ++q) {
+            if (fieldIndexes[q] < 0) continue;
+            if (!bounded[q] || zoneMap.overlapsTime(b, starts[q], ends[q])) active.push_back(q);
+        }
+        if (active.empty()) continue;
+
+        for (int base = zoneMap.getBlockBegin(b); base < zoneMap.getBlockEnd(b); base += WORD_BITS) {
+            word.load(data, base, zoneMap.getBlockEnd(b));
+            for (size_t a = 0; a < active.size(); ++a) {
+                size_t q = active[a];
+                // Invalid values are left out, as in the summaries
+                uint64_t mask = word.periodBits(queries[q]) & store.getValidity(fieldIndexes[q]).getWord(word.index);
+                word.appendSelected(fieldIndexes[q], mask, values[q]);
+            }
+        }
+    }
+}
+
+// Sums the absolute deviations from each query's centre in a single pass over the data.
+void CalcResults::sumAbsoluteDeviations(const std::vector<QuerySpec>& queries, const std::vector<float>& centres,
+                                        std::vector<double>& sums, std::vector<long long>& counts) const {
+    PROFILE_SCOPE("CalcResults::sumAbsoluteDeviations");
+    sums.assign(queries.size(), 0);
+    counts.assign(queries.size(), 0);
+    std::vector<int> fieldIndexes(queries.size(), -1);
+    std::vector<long long> starts(queries.size(), 0);
+    std::vector<long long> ends(queries.size(), 0);
+    std::vector<bool> bounded(queries.size(), false);
+    for (size_t q = 0; q < queries.size(); ++q) {
+        fieldIndexes[q] = WindTempSolar::getFieldIndex(queries[q].field);
+        bounded[q] = queries[q].getTimeRange(starts[q], ends[q]);
+    }
+    refreshZoneMap();
+    std::vector<size_t> active;
+    RecordWord word;
+
+    for (int b = 0; b < zoneMap.getBlockCount(); ++b) {
+        active.clear();
+        for (size_t q = 0; q < queries.size(); ++q) {
+            if (fieldIndexes[q] < 0) continue;
+            if (!bounded[q] || zoneMap.overlapsTime(b, starts[q], ends[q])) active.push_back(q);
+        }
+        if (active.empty()) continue;
+
+        for (int base = zoneMap.getBlockBegin(b); base < zoneMap.getBlockEnd(b); base += WORD_BITS) {
+            word.load(data, base, zoneMap.getBlockEnd(b));
+            for (size_t a = 0; a < active.size(); ++a) {
+                size_t q = active[a];
+                uint64_t mask = word.periodBits(queries[q]) & store.getValidity(fieldIndexes[q]).getWord(word.index);
+                sums[q] += word.absoluteDeviations(fieldIndexes[q], mask, centres[q]);
+                counts[q] += ValidityMask::countBits(mask);
+            }
+        }
+    }
+}
+
+// Computes all pending raw-data queries in a single pass over the data.
+void CalcResults::evaluateScan(const std::vector<QuerySpec>& queries, const std::vector<size_t>& pending, std::vector<float>& results) const {
+    PROFILE_SCOPE("CalcResults::evaluateScan");
+    PROFILE_COUNT("queries scanned", pending.size());
+    const int fieldCount = WindTempSolar::FIELD_COUNT;
+
+    // Group the queries by period so each record is matched against each period only once
+    std::vector<size_t> periods;               // Index of the first query of each period
+    std::vector<std::vector<size_t> > members; // Mean absolute deviation queries of each period
+    std::vector<std::vector<bool> > collect;   // Fields whose values must be kept for each period
+    std::vector<int> periodOf(queries.size(), -1);
+    std::vector<int> fieldIndexes(queries.size(), -1);
+    std::vector<float> means(queries.size(), 0);
+    std::vector<long long> counts(queries.size(), 0);
+    std::vector<double> sums(queries.size(), 0);
+
+    for (size_t i = 0; i < pending.size(); ++i) {
+        size_t q = pending[i];
+        size_t p = 0;
+        while (p < periods.size() && !queries[periods[p]].samePeriod(queries[q])) ++p;
+        if (p == periods.size()) {
+            periods.push_back(q);
+            members.push_back(std::vector<size_t>());
+            collect.push_back(std::vector<bool>(fieldCount, false));
+        }
+        periodOf[q] = (int)p;
+        fieldIndexes[q] = WindTempSolar::getFieldIndex(queries[q].field);
+        if (fieldIndexes[q] < 0) continue;
+
+        if (queries[q].metric == QuerySpec::MEAN_ABSOLUTE_DEVIATION) {
+            MonthlySummary summary = getSummary(queries[q]);
+            members[p].push_back(q);
+            means[q] = summary.getMean(queries[q].field);
+            counts[q] = summary.getValidCount(queries[q].field);
+        } else {
+            // Order statistics need the values of the period
+            collect[p][fieldIndexes[q]] = true;
+        }
+    }
+
+    // Values of each (period, field) needed by percentile queries
+    std::vector<std::vector<float> > values(periods.size() * fieldCount);
+
+    // Time windows of the periods, used to skip blocks that no period can match
+    std::vector<long long> starts(periods.size(), 0);
+    std::vector<long long> ends(periods.size(), 0);
+    std::vector<bool> bounded(periods.size(), false);
+    for (size_t p = 0; p < periods.size(); ++p) {
+        bounded[p] = queries[periods[p]].getTimeRange(starts[p], ends[p]);
+    }
+    refreshZoneMap();
+    std::vector<size_t> active;
+    RecordWord word;
+
+    // Iterate over the data once, accumulating every query
+    for (int b = 0; b < zoneMap.getBlockCount(); ++b) {
+        active.clear();
+        for (size_t p = 0; p < periods.size(); ++p) {
+            if (!bounded[p] || zoneMap.overlapsTime(b, starts[p], ends[p])) active.push_back(p);
+        }
+        if (active.empty()) continue;
+
+        for (int base = zoneMap.getBlockBegin(b); base < zoneMap.getBlockEnd(b); base += WORD_BITS) {
+            word.load(data, base, zoneMap.getBlockEnd(b));
+            for (size_t a = 0; a < active.size(); ++a) {
+                size_t p = active[a];
+                uint64_t period = word.periodBits(queries[periods[p]]);
+                if (period == 0) continue;
+                // Invalid (NaN) values are masked out, matching the valid counts of the summaries
+                for (size_t m = 0; m < members[p].size(); ++m) {
+                    size_t q = members[p][m];
+                    uint64_t mask = period & store.getValidity(fieldIndexes[q]).getWord(word.index);
+                    sums[q] += word.absoluteDeviations(fieldIndexes[q], mask, means[q]);
+                }
+                for (int f = 0; f < fieldCount; ++f) {
+                    if (collect[p][f]) word.appendSelected(f, period & store.getValidity(f).getWord(word.index), values[p * fieldCount + f]);
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < pending.size(); ++i) {
+        size_t q = pending[i];
+        if (fieldIndexes[q] < 0) {
+            results[q] = 0;
+        } else if (queries[q].metric == QuerySpec::MEAN_ABSOLUTE_DEVIATION) {
+            // Return the mean absolute deviation or 0 if no records were found
+            results[q] = (counts[q] > 0) ? (float)(sums[q] / counts[q]) : 0;
+        } else {
+            std::vector<float>& periodValues = values[periodOf[q] * fieldCount + fieldIndexes[q]];
+            if (queries[q].metric == QuerySpec::PERCENTILE) {
+                // Selection only reorders the values, so they can be shared with later queries
+                results[q] = Percentile::calculatePercentile(periodValues, queries[q].percentile);
+            } else {
+                // The deviation overwrites the values, so it works on a copy
+                std::vector<float> deviations(periodValues);
+                results[q] = Percentile::calculateMedianAbsoluteDeviation(deviations);
+            }
+        }
+    }
+}
+
+// Extends the zone map to cover records appended since the last query.
+void CalcResults::refreshZoneMap() const {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    if (zoneMap.getRecordCount() != data.size()) {
+        PROFILE_SCOPE("CalcResults zone map update");
+        zoneMap.update(data);
+    }
+}
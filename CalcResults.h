@@ -1,89 +1,341 @@
-#ifndef CALCRESULTS_H
-#define CALCRESULTS_H
-
-#include "Vector.h"
-#include "Bst.h"
-#include "WindTempSolar.h"
-#include "Math.h"
-#include <map>
-
-/**
- * @brief The CalcResults class provides functionality to calculate various results based on wind, temperature, and solar data.
- *
- * This class calculates statistics such as average wind speed, standard deviation, mean absolute deviation, total solar radiation, and sample Pearson correlation coefficient (SPCC).
- */
-class CalcResults {
-public:
-    /**
-     * @brief Constructor for CalcResults.
-     * @param data Vector of WindTempSolar objects containing the data.
-     * @param bstData Binary search tree of WindTempSolar objects containing the data.
-     * @param dataMap Map with date strings as keys and corresponding WindTempSolar objects as values.
-     */
-    CalcResults(const Vector<WindTempSolar>& data, const Bst<WindTempSolar>& bstData, const std::map<std::string, WindTempSolar>& dataMap);
-
-    /**
-     * @brief Calculate and return the average wind speed for the specified month and year.
-     * @param month The month for which to calculate the average wind speed.
-     * @param year The year for which to calculate the average wind speed.
-     * @return The average wind speed for the specified month and year.
-     */
-    float calculateAverageWindSpeed(int month, int year) const;
-
-    /**
-     * @brief Calculate and return the standard deviation of wind speed for the specified month and year.
-     * @param month The month for which to calculate the standard deviation of wind speed.
-     * @param year The year for which to calculate the standard deviation of wind speed.
-     * @return The standard deviation of wind speed for the specified month and year.
-     */
-    float calculateStandardDeviation(int month, int year) const;
-
-    /**
-     * @brief Calculate and return the average ambient air temperature for the specified month and year.
-     * @param month The month for which to calculate the average ambient air temperature.
-     * @param year The year for which to calculate the average ambient air temperature.
-     * @return The average ambient air temperature for the specified month and year.
-     */
-    float calculateAverageAmbientTemperature(int month, int year) const;
-
-    /**
-     * @brief Calculate and return the total solar radiation for the specified month and year.
-     * @param month The month for which to calculate the total solar radiation.
-     * @param year The year for which to calculate the total solar radiation.
-     * @return The total solar radiation for the specified month and year.
-     */
-    float calculateTotalSolarRadiation(int month, int year) const;
-
-    /**
-     * @brief Calculate and return the mean absolute deviation of wind speed for the specified month and year.
-     * @param month The month for which to calculate the mean absolute deviation of wind speed.
-     * @param year The year for which to calculate the mean absolute deviation of wind speed.
-     * @return The mean absolute deviation of wind speed for the specified month and year.
-     */
-    float calculateWindSpeedMAD(int month, int year) const;
-
-    /**
-     * @brief Calculate and return the mean absolute deviation of temperature for the specified month and year.
-     * @param month The month for which to calculate the mean absolute deviation of temperature.
-     * @param year The year for which to calculate the mean absolute deviation of temperature.
-     * @return The mean absolute deviation of temperature for the specified month and year.
-     */
-    float calculateTemperatureMAD(int month, int year) const;
-
-    /**
-     * @brief Calculate and return the sample Pearson correlation coefficient (SPCC) between wind speed and temperature for the specified month and year.
-     * @param month The month for which to calculate the SPCC.
-     * @param field1 The field representing the first variable (e.g., "wind_speed").
-     * @param field2 The field representing the second variable (e.g., "temperature").
-     * @return The sample Pearson correlation coefficient (SPCC) between wind speed and temperature for the specified month.
-     */
-    float calculateSPCC(int month, const std::string& field1, const std::string& field2) const;
-
-private:
-    const Vector<WindTempSolar>& data; /**< Vector of WindTempSolar objects containing the data. */
-    const Bst<WindTempSolar>& bstData; /**< Binary search tree of WindTempSolar objects containing the data. */
-    const std::map<std::string, WindTempSolar>& dataMap; /**< Map with date strings as keys and corresponding WindTempSolar objects as values. */
-};
-
-#endif // CALCRESULTS_H
-
+#ifndef CALCRESULTS_H
+#define CALCRESULTS_H
+
+#include "Vector.h"
+#include "RecordStore.h"
+#include "WindTempSolar.h"
+#include "Math.h"
+#include "SummaryCube.h"
+#include "ResultCache.h"
+#include "QuerySpec.h"
+#include "Histogram.h"
+#include "WeibullFit.h"
+#include "RollingStatistics.h"
+#include "Resampler.h"
+#include "ZoneMap.h"
+#include "RangeQuery.h"
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief The CalcResults class provides functionality to calculate various results based on wind, temperature, and solar data.
+ *
+ * This class calculates statistics such as average wind speed, standard deviation, mean absolute deviation, total solar radiation, and sample Pearson correlation coefficient (SPCC).
+ * Means, standard deviations, totals, SPCC and approximate percentiles are answered from the precomputed
+ * SummaryCube; means, totals and counts over hourly or daily windows are answered from the resampled
+ * series (see getSeries); only deviations and exact percentiles need a scan of the raw data. Results are kept in a bounded cache that is
+ * invalidated whenever the cube's generation changes, so repeated queries are not recomputed.
+ * Queries may run concurrently from several threads as long as no data is being added.
+ */
+class CalcResults {
+public:
+    /**
+     * @brief Constructor for CalcResults.
+     * @param store The record store holding the data.
+     * @param cube Per-month summaries of the same data, maintained during ingest.
+     * @param cacheCapacity The maximum number of query results kept in the result cache.
+     */
+    CalcResults(const RecordStore& store, const SummaryCube& cube, size_t cacheCapacity = 1024);
+
+    /**
+     * @brief Calculate and return the average wind speed for the specified month and year.
+     * @param month The month for which to calculate the average wind speed.
+     * @param year The year for which to calculate the average wind speed.
+     * @return The average wind speed for the specified month and year.
+     */
+    float calculateAverageWindSpeed(int month, int year) const;
+
+    /**
+     * @brief Calculate and return the standard deviation of wind speed for the specified month and year.
+     * @param month The month for which to calculate the standard deviation of wind speed.
+     * @param year The year for which to calculate the standard deviation of wind speed.
+     * @return The standard deviation of wind speed for the specified month and year.
+     */
+    float calculateStandardDeviation(int month, int year) const;
+
+    /**
+     * @brief Calculate and return the average ambient air temperature for the specified month and year.
+     * @param month The month for which to calculate the average ambient air temperature.
+     * @param year The year for which to calculate the average ambient air temperature.
+     * @return The average ambient air temperature for the specified month and year.
+     */
+    float calculateAverageAmbientTemperature(int month, int year) const;
+
+    /**
+     * @brief Calculate and return the total solar radiation for the specified month and year.
+     * @param month The month for which to calculate the total solar radiation.
+     * @param year The year for which to calculate the total solar radiation.
+     * @return The total solar radiation for the specified month and year.
+     */
+    float calculateTotalSolarRadiation(int month, int year) const;
+
+    /**
+     * @brief Calculate and return the mean absolute deviation of wind speed for the specified month and year.
+     * @param month The month for which to calculate the mean absolute deviation of wind speed.
+     * @param year The year for which to calculate the mean absolute deviation of wind speed.
+     * @return The mean absolute deviation of wind speed for the specified month and year.
+     */
+    float calculateWindSpeedMAD(int month, int year) const;
+
+    /**
+     * @brief Calculate and return the mean absolute deviation of temperature for the specified month and year.
+     * @param month The month for which to calculate the mean absolute deviation of temperature.
+     * @param year The year for which to calculate the mean absolute deviation of temperature.
+     * @return The mean absolute deviation of temperature for the specified month and year.
+     */
+    float calculateTemperatureMAD(int month, int year) const;
+
+    /**
+     * @brief Calculate and return the sample Pearson correlation coefficient (SPCC) between wind speed and temperature for the specified month and year.
+     * @param month The month for which to calculate the SPCC.
+     * @param field1 The field representing the first variable (e.g., "wind_speed").
+     * @param field2 The field representing the second variable (e.g., "temperature").
+     * @return The sample Pearson correlation coefficient (SPCC) between wind speed and temperature for the specified month.
+     */
+    float calculateSPCC(int month, const std::string& field1, const std::string& field2) const;
+
+    /**
+     * @brief Calculate and return an exact percentile of a field for the specified month and year.
+     * @param field The field (e.g., "wind_speed").
+     * @param percentile The percentile to calculate (0-100), e.g. 90 for P90.
+     * @param month The month for which to calculate the percentile.
+     * @param year The year for which to calculate the percentile (0 for all years).
+     * @return The percentile of the field for the specified month and year.
+     */
+    float calculatePercentile(const std::string& field, float percentile, int month, int year) const;
+
+    /**
+     * @brief Estimate a percentile of a field for the specified month and year from the summary cube.
+     *
+     * Uses the per-month t-digests maintained during ingest, so no raw data is scanned.
+     *
+     * @param field The field (e.g., "wind_speed").
+     * @param percentile The percentile to estimate (0-100).
+     * @param month The month for which to estimate the percentile.
+     * @param year The year for which to estimate the percentile (0 for all years).
+     * @return The estimated percentile of the field for the specified month and year.
+     */
+    float calculateApproximatePercentile(const std::string& field, float percentile, int month, int year) const;
+
+    /**
+     * @brief Calculate and return the median absolute deviation of a field for the specified month and year.
+     * @param field The field (e.g., "temperature").
+     * @param month The month for which to calculate the median absolute deviation.
+     * @param year The year for which to calculate the median absolute deviation (0 for all years).
+     * @return The median absolute deviation of the field for the specified month and year.
+     */
+    float calculateMedianAbsoluteDeviation(const std::string& field, int month, int year) const;
+
+    /**
+     * @brief Return the wind speed histogram for the specified month and year.
+     *
+     * The histogram is maintained in the summary cube during ingest, so no data is scanned.
+     *
+     * @param month The month of the histogram.
+     * @param year The year of the histogram (0 for all years).
+     * @return The wind speed histogram for the specified month and year.
+     */
+    Histogram getWindSpeedHistogram(int month, int year) const;
+
+    /**
+     * @brief Fit Weibull shape and scale parameters to the wind speeds of the specified month and year.
+     * @param month The month for which to fit the distribution.
+     * @param year The year for which to fit the distribution (0 for all years).
+     * @return The fitted Weibull parameters.
+     */
+    WeibullFit fitWindSpeedWeibull(int month, int year) const;
+
+    /**
+     * @brief Calculate rolling statistics of a field over the time-ordered data.
+     *
+     * All window lengths are computed in a single pass over the store's timestamp index; see
+     * RollingStatistics::calculate.
+     *
+     * @param field The field to aggregate (e.g., "wind_speed").
+     * @param durations The window lengths in minutes (e.g., RollingStatistics::HOUR).
+     * @return For each window length, one RollingPoint per record, in timestamp order.
+     */
+    std::vector<std::vector<RollingPoint> > calculateRollingStatistics(const std::string& field, const std::vector<long long>& durations) const;
+
+    /**
+     * @brief Return the data resampled into fixed time buckets.
+     *
+     * The series is built in one pass on first use and kept until new data is ingested,
+     * so hourly and daily queries afterwards read the compact series instead of raw rows.
+     * The returned reference stays valid until the next call after new data is ingested.
+     *
+     * @param bucketMinutes The bucket length in minutes (e.g., Resampler::HOURLY or Resampler::DAILY).
+     * @return The resampled series.
+     */
+    const SeriesStore& getSeries(long long bucketMinutes) const;
+
+    /**
+     * @brief Calculate and return the average of a field over an arbitrary time window.
+     *
+     * Blocks of records outside the window are skipped using the zone map.
+     *
+     * @param field The field to average (e.g., "wind_speed").
+     * @param start The start of the window in minutes since 1 January 1970 (see WindTempSolar::getTimestamp).
+     * @param end The end of the window (exclusive).
+     * @return The average of the field over the window.
+     */
+    float calculateAverageInWindow(const std::string& field, long long start, long long end) const;
+
+    /**
+     * @brief Count the records in a time window whose field lies in [minValue, maxValue].
+     *
+     * Blocks that cannot match the window or the value range are skipped using the zone map.
+     *
+     * @param field The field to test (e.g., "wind_speed").
+     * @param minValue The lowest accepted value.
+     * @param maxValue The highest accepted value.
+     * @param start The start of the window in minutes since 1 January 1970.
+     * @param end The end of the window (exclusive).
+     * @return The number of matching records.
+     */
+    long long countRecordsInRange(const std::string& field, float minValue, float maxValue, long long start, long long end) const;
+
+    /**
+     * @brief Evaluate a range query and return one summary per group.
+     *
+     * The range may span any number of months and years. Whole months inside the range are
+     * merged from the summary cube without touching the raw data; only the partial months
+     * at either end of the range are read, through the store's timestamp index. Gaps and
+     * duplicates of the partial months are counted from the records in the range with the
+     * cube's sampling interval, so their coverage matches that of whole months.
+     *
+     * @param query The time range and grouping.
+     * @return The summaries of the groups that contain data, in chronological order.
+     */
+    std::vector<GroupResult> evaluateRange(const RangeQuery& query) const;
+
+    /**
+     * @brief Evaluate a list of queries together and return all results in one go.
+     *
+     * Queries answerable from the summary cube are resolved immediately. Deviation and
+     * exact percentile queries are grouped by period and all of them are computed in a
+     * single scan over the data, however many periods and fields are requested. Blocks of
+     * records outside every requested period are skipped using the zone map.
+     *
+     * @param queries The queries to evaluate.
+     * @return The results, in the same order as the queries.
+     */
+    std::vector<float> evaluateBatch(const std::vector<QuerySpec>& queries) const;
+
+    /**
+     * @brief Returns the number of queries answered from the result cache.
+     * @return The number of cache hits.
+     */
+    unsigned long long getCacheHits() const;
+
+    /**
+     * @brief Returns the number of queries that had to be computed.
+     * @return The number of cache misses.
+     */
+    unsigned long long getCacheMisses() const;
+
+    /**
+     * @brief Returns the summary of the period covered by a query.
+     *
+     * Summaries of several datasets can be merged, so this is used to combine partitions.
+     *
+     * @param query The query.
+     * @return The summary of the query period.
+     */
+    MonthlySummary getSummary(const QuerySpec& query) const;
+
+    /**
+     * @brief Returns the percentile digest of the field and period of a query.
+     * @param query The query.
+     * @return The digest of the query period.
+     */
+    TDigest getDigest(const QuerySpec& query) const;
+
+    /**
+     * @brief Returns the counts and sums of the time window of a query.
+     *
+     * Windows of whole days are read from the daily series, windows of whole hours from the
+     * hourly series, and other windows from a series of one-minute buckets. Aggregates of
+     * several datasets can be merged, so this is used to combine partitions.
+     *
+     * @param query A window query.
+     * @return The aggregate of the window.
+     */
+    SeriesBucket getWindowAggregate(const QuerySpec& query) const;
+
+    /**
+     * @brief Collects the field values of each query's period in one scan over the data.
+     *
+     * Used to compute order statistics over several datasets together.
+     *
+     * @param queries The queries.
+     * @param values Receives the values of each query, in the same order as the queries.
+     */
+    void collectValues(const std::vector<QuerySpec>& queries, std::vector<std::vector<float> >& values) const;
+
+    /**
+     * @brief Sums the absolute deviations of each query's field from a given centre in one scan over the data.
+     *
+     * The sums and counts of several datasets add up, so a mean absolute deviation around the
+     * combined mean can be computed without gathering the values.
+     *
+     * @param queries The queries.
+     * @param centres The centre of each query, usually the combined mean.
+     * @param sums Receives the sum of absolute deviations of each query.
+     * @param counts Receives the number of valid values of each query.
+     */
+    void sumAbsoluteDeviations(const std::vector<QuerySpec>& queries, const std::vector<float>& centres,
+                               std::vector<double>& sums, std::vector<long long>& counts) const;
+
+    /**
+     * @brief Computes a cube-answerable metric from the summary of its period.
+     * @param query The query.
+     * @param summary The summary of the query period.
+     * @return The value of the metric.
+     */
+    static float evaluateSummary(const QuerySpec& query, const MonthlySummary& summary);
+
+    /**
+     * @brief Computes a window metric from the aggregate of its window.
+     * @param query The window query.
+     * @param aggregate The aggregate of the window.
+     * @return The mean, total or count, or 0 for metrics windows do not support.
+     */
+    static float evaluateWindow(const QuerySpec& query, const SeriesBucket& aggregate);
+
+private:
+    /**
+     * @brief Returns a cached result, computing and caching it on a miss.
+     * @param query The query.
+     * @param compute Function computing the result on a miss.
+     * @return The result of the query.
+     */
+    float getCachedResult(const QuerySpec& query, const std::function<float()>& compute) const;
+
+    /**
+     * @brief Computes the given raw-data queries in one scan over the data.
+     * @param queries All queries of the batch.
+     * @param pending Indexes of the queries to compute.
+     * @param results Receives the results at the indexes of the computed queries.
+     */
+    void evaluateScan(const std::vector<QuerySpec>& queries, const std::vector<size_t>& pending, std::vector<float>& results) const;
+
+    /**
+     * @brief Brings the zone map up to date with the data.
+     */
+    void refreshZoneMap() const;
+
+    const RecordStore& store; /**< Record store holding the data. */
+    const Vector<WindTempSolar>& data; /**< The records of the store in load order. */
+    const SummaryCube& cube; /**< Per-month summaries of the data. */
+    mutable ResultCache cache; /**< Cache of query results keyed by metric, month, year and fields. */
+    mutable std::map<long long, SeriesStore> seriesCache; /**< Resampled series keyed by bucket length. */
+    mutable unsigned long long seriesGeneration; /**< Dataset generation the resampled series were built from. */
+    mutable ZoneMap zoneMap; /**< Per-block ranges of the data, extended as data is appended. */
+    mutable std::mutex indexMutex; /**< Guards the zone map and the resampled series. */
+};
+
+#endif // CALCRESULTS_H
+
@@ -0,0 +1,441 @@
+#include "CompressedSeries.h"
+#include "BitStream.h"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace {
+const char MAGIC[4] = { 'W', 'T', 'S', 'C' };
+const uint32_t FORMAT_VERSION = 1;
+const int MAX_DECIMALS = 3;
+const long long MAX_TIMESTAMP = 1LL << 40;  // Bound on stored timestamps, about two million years either side of 1970
+const long long MAX_FIXED = 1000000000000LL;  // Bound on fixed-point values, the range findDecimals accepts
+
+// Reinterprets the bits of a float as an integer
+uint32_t floatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Reinterprets the bits of an integer as a float
+float bitsFloat(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Counts leading zero bits of a non-zero 32-bit value
+int leadingZeros(uint32_t value) {
+    int count = 0;
+    while (!(value & 0x80000000u)) { value <<= 1; count++; }
+    return count;
+}
+
+// Counts trailing zero bits of a non-zero 32-bit value
+int trailingZeros(uint32_t value) {
+    int count = 0;
+    while (!(value & 1u)) { value >>= 1; count++; }
+    return count;
+}
+
+// Converts a fixed-point integer back to the float it encodes
+float fixedToFloat(long long fixed, double scale) {
+    return (float)(fixed / scale);
+}
+
+// Finds the fewest decimals (0-3) for which every value round-trips exactly, or -1
+int findDecimals(const std::vector<float>& values) {
+    double scale = 1;
+    for (int decimals = 0; decimals <= MAX_DECIMALS; ++decimals, scale *= 10) {
+        bool exact = true;
+        for (size_t i = 0; i < values.size() && exact; ++i) {
+            double scaled = values[i] * scale;
+            // Also rejects NaN and infinities, which fail the range check
+            if (!(std::fabs(scaled) < 1e12)) { exact = false; break; }
+            long long fixed = std::llround(scaled);
+            exact = floatBits(fixedToFloat(fixed, scale)) == floatBits(values[i]);
+        }
+        if (exact) return decimals;
+    }
+    return -1;
+}
+
+// Writes values as fixed-point integers, each stored as the difference from the previous one
+void encodeFixed(const std::vector<float>& values, int decimals, std::vector<unsigned char>& out) {
+    BitWriter writer(out);
+    double scale = std::pow(10.0, decimals);
+    long long previous = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+        long long fixed = std::llround(values[i] * scale);
+        writer.writeSigned(fixed - previous);
+        previous = fixed;
+    }
+}
+
+// Writes values with Gorilla XOR encoding
+void encodeXor(const std::vector<float>& values, std::vector<unsigned char>& out) {
+    BitWriter writer(out);
+    uint32_t previous = floatBits(values[0]);
+    writer.write(previous, 32);
+    int previousLeading = -1;
+    int previousTrailing = 0;
+    for (size_t i = 1; i < values.size(); ++i) {
+        uint32_t bits = floatBits(values[i]);
+        uint32_t difference = bits ^ previous;
+        previous = bits;
+        if (difference == 0) {
+            // Same value as before
+            writer.write(0, 1);
+            continue;
+        }
+        writer.write(1, 1);
+        int leading = leadingZeros(difference);
+        int trailing = trailingZeros(difference);
+        if (leading > 31) leading = 31;
+        if (previousLeading >= 0 && leading >= previousLeading && trailing >= previousTrailing) {
+            // The meaningful bits fit in the previous window
+            writer.write(0, 1);
+            writer.write(difference >> previousTrailing, 32 - previousLeading - previousTrailing);
+        } else {
+            int length = 32 - leading - trailing;
+            writer.write(1, 1);
+            writer.write(leading, 5);
+            writer.write(length - 1, 5);
+            writer.write(difference >> trailing, length);
+            previousLeading = leading;
+            previousTrailing = trailing;
+        }
+    }
+}
+
+// Reads values written by encodeXor, stopping at a window that does not fit in 32 bits
+bool decodeXor(const std::vector<unsigned char>& in, int count, std::vector<float>& values) {
+    BitReader reader(in.data(), in.size());
+    uint32_t previous = (uint32_t)reader.read(32);
+    values.push_back(bitsFloat(previous));
+    int leading = 0;
+    int trailing = 0;
+    for (int i = 1; i < count; ++i) {
+        if (reader.read(1) != 0) {
+            if (reader.read(1) != 0) {
+                leading = (int)reader.read(5);
+                int length = (int)reader.read(5) + 1;
+                // Only corrupt data has a window past the last bit, which would make the shift undefined
+                if (leading + length > 32) return false;
+                trailing = 32 - leading - length;
+            }
+            previous ^= (uint32_t)reader.read(32 - leading - trailing) << trailing;
+        }
+        values.push_back(bitsFloat(previous));
+    }
+    return true;
+}
+
+// Returns true if a value lies in [-bound, bound]
+bool withinBound(long long value, long long bound) {
+    return value >= -bound && value <= bound;
+}
+
+// Writes a length-prefixed byte buffer
+void writeBytes(std::ofstream& file, const std::vector<unsigned char>& bytes) {
+    uint32_t size = (uint32_t)bytes.size();
+    file.write((const char*)&size, sizeof(size));
+    if (size > 0) file.write((const char*)bytes.data(), size);
+}
+
+// Reads a fixed-size value, counting it against the bytes left in the file
+bool readValue(std::ifstream& file, void* value, size_t size, unsigned long long& remaining) {
+    if (size > remaining || !file.read((char*)value, size)) return false;
+    remaining -= size;
+    return true;
+}
+
+// Reads a length-prefixed byte buffer, rejecting lengths beyond the end of the file
+bool readBytes(std::ifstream& file, std::vector<unsigned char>& bytes, unsigned long long& remaining) {
+    uint32_t size = 0;
+    if (!readValue(file, &size, sizeof(size), remaining) || size > remaining) return false;
+    bytes.resize(size);
+    return size == 0 || readValue(file, bytes.data(), size, remaining);
+}
+}
+
+// Default constructor creates an empty series
+CompressedSeries::CompressedSeries() : recordCount(0) {}
+
+// Compresses all records of a vector
+CompressedSeries CompressedSeries::compress(const Vector<WindTempSolar>& data) {
+    CompressedSeries series;
+    for (int i = 0; i < data.size(); ++i) {
+        series.append(data[i]);
+    }
+    series.flush();
+    return series;
+}
+
+// Buffers a record, compressing a block when enough records are pending
+void CompressedSeries::append(const WindTempSolar& record) {
+    pendingTimestamps.push_back(record.getTimestamp());
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+        pendingValues[f].push_back(record.getValue(f));
+    }
+    if ((int)pendingTimestamps.size() >= BLOCK_SIZE) {
+        sealBlock();
+    }
+}
+
+// Compresses any pending records into a final block
+void CompressedSeries::flush() {
+    if (!pendingTimestamps.empty()) {
+        sealBlock();
+    }
+}
+
+// Returns the number of records in compressed blocks
+long long CompressedSeries::getRecordCount() const {
+    return recordCount;
+}
+
+// Returns the number of blocks
+int CompressedSeries::getBlockCount() const {
+    return (int)blocks.size();
+}
+
+// Returns the number of records in a block
+int CompressedSeries::getBlockSize(int block) const {
+    return blocks[block].count;
+}
+
+// Returns the earliest timestamp of a block
+long long CompressedSeries::getBlockMinTimestamp(int block) const {
+    return blocks[block].minTimestamp;
+}
+
+// Returns the latest timestamp of a block
+long long CompressedSeries::getBlockMaxTimestamp(int block) const {
+    return blocks[block].maxTimestamp;
+}
+
+// Returns the size of the encoded columns in bytes
+size_t CompressedSeries::getCompressedBytes() const {
+    size_t bytes = 0;
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        bytes += sizeof(Block) + blocks[b].timestamps.size();
+        for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+            bytes += blocks[b].channels[f].size();
+        }
+    }
+    return bytes;
+}
+
+// Decodes the delta-of-delta timestamps of a block
+void CompressedSeries::decodeTimestamps(int block, std::vector<long long>& timestamps) const {
+    const Block& current = blocks[block];
+    timestamps.clear();
+    timestamps.reserve(current.count);
+    BitReader reader(current.timestamps.data(), current.timestamps.size());
+    long long timestamp = reader.readSigned();
+    timestamps.push_back(timestamp);
+    long long delta = 0;
+    for (int i = 1; i < current.count; ++i) {
+        if (i == 1) {
+            delta = reader.readSigned();
+        } else if (reader.read(1) != 0) {
+            delta += reader.readSigned();
+        }
+        timestamp += delta;
+        timestamps.push_back(timestamp);
+    }
+}
+
+// Decodes one float channel of a block
+void CompressedSeries::decodeChannel(int block, int fieldIndex, std::vector<float>& values) const {
+    const Block& current = blocks[block];
+    values.clear();
+    if (fieldIndex < 0 || fieldIndex >= WindTempSolar::FIELD_COUNT) return;
+    values.reserve(current.count);
+    if (current.encodings[fieldIndex] == 0) {
+        // Blocks are checked by load(), so this only fails on memory corruption; the record count is kept
+        if (!decodeXor(current.channels[fieldIndex], current.count, values)) values.resize(current.count, NAN);
+        return;
+    }
+    double scale = std::pow(10.0, current.encodings[fieldIndex] - 1);
+    BitReader reader(current.channels[fieldIndex].data(), current.channels[fieldIndex].size());
+    long long fixed = 0;
+    for (int i = 0; i < current.count; ++i) {
+        fixed += reader.readSigned();
+        values.push_back(fixedToFloat(fixed, scale));
+    }
+}
+
+// Decompresses all records into a vector
+void CompressedSeries::decompress(Vector<WindTempSolar>& data) const {
+    std::vector<long long> timestamps;
+    std::vector<float> values[WindTempSolar::FIELD_COUNT];
+    for (int b = 0; b < getBlockCount(); ++b) {
+        decodeTimestamps(b, timestamps);
+        for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+            decodeChannel(b, f, values[f]);
+        }
+        for (int i = 0; i < blocks[b].count; ++i) {
+            long long day = timestamps[i] / (24 * 60);
+            long long minute = timestamps[i] % (24 * 60);
+            if (minute < 0) { minute += 24 * 60; day--; }
+            data.push_back(WindTempSolar(Date::fromDayNumber(day), Time((int)(minute / 60), (int)(minute % 60)), values[0][i], values[1][i], values[2][i]));
+        }
+    }
+}
+
+// Writes the series to a binary file
+bool CompressedSeries::save(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) return false;
+    uint32_t blockCount = (uint32_t)blocks.size();
+    file.write(MAGIC, sizeof(MAGIC));
+    file.write((const char*)&FORMAT_VERSION, sizeof(FORMAT_VERSION));
+    file.write((const char*)&recordCount, sizeof(recordCount));
+    file.write((const char*)&blockCount, sizeof(blockCount));
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        const Block& block = blocks[b];
+        file.write((const char*)&block.count, sizeof(block.count));
+        file.write((const char*)&block.minTimestamp, sizeof(block.minTimestamp));
+        file.write((const char*)&block.maxTimestamp, sizeof(block.maxTimestamp));
+        file.write((const char*)block.encodings, sizeof(block.encodings));
+        writeBytes(file, block.timestamps);
+        for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+            writeBytes(file, block.channels[f]);
+        }
+    }
+    return (bool)file;
+}
+
+// Replaces the series with the contents of a file written by save()
+bool CompressedSeries::load(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return false;
+    std::streamoff length = file.tellg();
+    if (length < 0 || !file.seekg(0)) return false;
+    unsigned long long remaining = (unsigned long long)length;
+
+    char magic[4];
+    uint32_t version = 0;
+    long long count = 0;
+    uint32_t blockCount = 0;
+    if (!readValue(file, magic, sizeof(magic), remaining) || !readValue(file, &version, sizeof(version), remaining)
+        || !readValue(file, &count, sizeof(count), remaining) || !readValue(file, &blockCount, sizeof(blockCount), remaining)) return false;
+    if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != FORMAT_VERSION || count < 0) return false;
+
+    // Every block takes at least its header and the lengths of its buffers, which bounds the block count by the file size
+    const unsigned long long minBlockBytes = sizeof(int) + 2 * sizeof(long long) + WindTempSolar::FIELD_COUNT
+                                             + (1 + WindTempSolar::FIELD_COUNT) * sizeof(uint32_t);
+    if (blockCount > remaining / minBlockBytes) return false;
+
+    // Read into a separate list so the series is unchanged if the file turns out to be corrupt
+    std::vector<Block> loaded(blockCount);
+    long long total = 0;
+    for (uint32_t b = 0; b < blockCount; ++b) {
+        Block& block = loaded[b];
+        if (!readValue(file, &block.count, sizeof(block.count), remaining)
+            || !readValue(file, &block.minTimestamp, sizeof(block.minTimestamp), remaining)
+            || !readValue(file, &block.maxTimestamp, sizeof(block.maxTimestamp), remaining)
+            || !readValue(file, block.encodings, sizeof(block.encodings), remaining)) return false;
+        if (block.count <= 0 || block.count > BLOCK_SIZE || block.minTimestamp > block.maxTimestamp) return false;
+        if (!readBytes(file, block.timestamps, remaining)) return false;
+        for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+            if (block.encodings[f] > MAX_DECIMALS + 1 || !readBytes(file, block.channels[f], remaining)) return false;
+        }
+        if (!isValidBlock(block)) return false;
+        total += block.count;
+    }
+    if (total != count || remaining != 0) return false;
+    blocks.swap(loaded);
+    recordCount = count;
+    pendingTimestamps.clear();
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) pendingValues[f].clear();
+    return true;
+}
+
+// Decodes a block with every step checked, so the unchecked decoders never see values that overflow
+bool CompressedSeries::isValidBlock(const Block& block) {
+    if (!withinBound(block.minTimestamp, MAX_TIMESTAMP) || !withinBound(block.maxTimestamp, MAX_TIMESTAMP)) return false;
+
+    // Consecutive timestamps lie in [min, max], which bounds every delta and change of delta
+    long long span = block.maxTimestamp - block.minTimestamp;
+    BitReader timestampReader(block.timestamps.data(), block.timestamps.size());
+    long long timestamp = timestampReader.readSigned();
+    if (timestamp < block.minTimestamp || timestamp > block.maxTimestamp) return false;
+    long long delta = 0;
+    for (int i = 1; i < block.count; ++i) {
+        if (i == 1 || timestampReader.read(1) != 0) {
+            long long change = timestampReader.readSigned();
+            if (!withinBound(change, 2 * span)) return false;
+            delta = (i == 1) ? change : delta + change;
+            if (!withinBound(delta, span)) return false;
+        }
+        timestamp += delta;
+        if (timestamp < block.minTimestamp || timestamp > block.maxTimestamp) return false;
+    }
+
+    std::vector<float> values;
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+        if (block.encodings[f] == 0) {
+            values.clear();
+            if (!decodeXor(block.channels[f], block.count, values)) return false;
+            continue;
+        }
+        BitReader reader(block.channels[f].data(), block.channels[f].size());
+        long long fixed = 0;
+        for (int i = 0; i < block.count; ++i) {
+            long long difference = reader.readSigned();
+            if (!withinBound(difference, 2 * MAX_FIXED)) return false;
+            fixed += difference;
+            if (!withinBound(fixed, MAX_FIXED)) return false;
+        }
+    }
+    return true;
+}
+
+// Encodes the pending records into a new block
+void CompressedSeries::sealBlock() {
+    Block block;
+    block.count = (int)pendingTimestamps.size();
+    block.minTimestamp = pendingTimestamps[0];
+    block.maxTimestamp = pendingTimestamps[0];
+
+    // Timestamps: first value, first delta, then a zero bit or a one bit and the delta change
+    BitWriter writer(block.timestamps);
+    writer.writeSigned(pendingTimestamps[0]);
+    long long previousDelta = 0;
+    for (int i = 1; i < block.count; ++i) {
+        long long timestamp = pendingTimestamps[i];
+        if (timestamp < block.minTimestamp) block.minTimestamp = timestamp;
+        if (timestamp > block.maxTimestamp) block.maxTimestamp = timestamp;
+        long long delta = timestamp - pendingTimestamps[i - 1];
+        if (i == 1) {
+            writer.writeSigned(delta);
+        } else if (delta == previousDelta) {
+            writer.write(0, 1);
+        } else {
+            writer.write(1, 1);
+            writer.writeSigned(delta - previousDelta);
+        }
+        previousDelta = delta;
+    }
+
+    // Channels: fixed point when exact, XOR otherwise
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+        int decimals = findDecimals(pendingValues[f]);
+        if (decimals >= 0) {
+            block.encodings[f] = (unsigned char)(decimals + 1);
+            encodeFixed(pendingValues[f], decimals, block.channels[f]);
+        } else {
+            block.encodings[f] = 0;
+            encodeXor(pendingValues[f], block.channels[f]);
+        }
+        pendingValues[f].clear();
+    }
+
+    recordCount += block.count;
+    pendingTimestamps.clear();
+    blocks.push_back(block);
+}
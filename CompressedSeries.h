@@ -0,0 +1,176 @@
+#ifndef COMPRESSEDSERIES_H
+#define COMPRESSEDSERIES_H
+
+#include "Vector.h"
+#include "WindTempSolar.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Opt-in compressed, column-oriented storage of WindTempSolar records.
+ *
+ * Records are grouped into blocks of BLOCK_SIZE. Within a block, timestamps are stored as
+ * delta-of-delta values (one bit per record for regular 10-minute data). Each float
+ * channel is stored either as fixed-point integers with delta encoding, when every value of
+ * the block round-trips exactly with up to three decimals, or with Gorilla-style XOR
+ * encoding otherwise. Decoding is always bit-exact.
+ *
+ * Blocks are decoded independently and one column at a time, so aggregations can stream
+ * through the compressed data and skip blocks whose time range cannot match.
+ */
+class CompressedSeries {
+public:
+    /** Number of records per block. */
+    static const int BLOCK_SIZE = 1024;
+
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs an empty series.
+     */
+    CompressedSeries();
+
+    /**
+     * @brief Compresses all records of a vector.
+     *
+     * @param data Vector of WindTempSolar objects.
+     * @return The compressed series.
+     */
+    static CompressedSeries compress(const Vector<WindTempSolar>& data);
+
+    /**
+     * @brief Appends a record. A block is compressed each time BLOCK_SIZE records are pending.
+     *
+     * @param record The record to append.
+     */
+    void append(const WindTempSolar& record);
+
+    /**
+     * @brief Compresses any pending records into a final, partial block.
+     *
+     * Must be called after the last append() so the pending records become visible to readers.
+     */
+    void flush();
+
+    /**
+     * @brief Returns the number of records in compressed blocks.
+     *
+     * @return The number of records.
+     */
+    long long getRecordCount() const;
+
+    /**
+     * @brief Returns the number of blocks.
+     *
+     * @return The number of blocks.
+     */
+    int getBlockCount() const;
+
+    /**
+     * @brief Returns the number of records in a block.
+     *
+     * @param block The index of the block.
+     * @return The number of records.
+     */
+    int getBlockSize(int block) const;
+
+    /**
+     * @brief Returns the earliest timestamp of a block.
+     *
+     * @param block The index of the block.
+     * @return The earliest timestamp in minutes since 1 January 1970.
+     */
+    long long getBlockMinTimestamp(int block) const;
+
+    /**
+     * @brief Returns the latest timestamp of a block.
+     *
+     * @param block The index of the block.
+     * @return The latest timestamp in minutes since 1 January 1970.
+     */
+    long long getBlockMaxTimestamp(int block) const;
+
+    /**
+     * @brief Returns the size of the compressed data in bytes.
+     *
+     * @return The number of bytes used by the encoded columns.
+     */
+    size_t getCompressedBytes() const;
+
+    /**
+     * @brief Decodes the timestamps of a block.
+     *
+     * @param block The index of the block.
+     * @param timestamps Receives the timestamps, replacing its contents.
+     */
+    void decodeTimestamps(int block, std::vector<long long>& timestamps) const;
+
+    /**
+     * @brief Decodes one float channel of a block.
+     *
+     * @param block The index of the block.
+     * @param fieldIndex The index of the field (see WindTempSolar::getFieldIndex).
+     * @param values Receives the values, replacing its contents.
+     */
+    void decodeChannel(int block, int fieldIndex, std::vector<float>& values) const;
+
+    /**
+     * @brief Decompresses all records into a vector.
+     *
+     * @param data Vector receiving the records.
+     */
+    void decompress(Vector<WindTempSolar>& data) const;
+
+    /**
+     * @brief Writes the series to a binary file.
+     *
+     * The file uses the byte order of the machine that wrote it.
+     *
+     * @param filename The name of the file.
+     * @return true if the file was written, false otherwise.
+     */
+    bool save(const std::string& filename) const;
+
+    /**
+     * @brief Replaces the series with the contents of a file written by save().
+     *
+     * Sizes read from the file are checked against the file length, and the block record
+     * counts against the stored total. Every block is then decoded with each step checked, so
+     * corrupt encoded data is also rejected. A rejected file leaves the series unchanged.
+     *
+     * @param filename The name of the file.
+     * @return true if the file was read, false if it cannot be opened or is not a valid series.
+     */
+    bool load(const std::string& filename);
+
+private:
+    // Block holds the encoded columns of up to BLOCK_SIZE records
+    struct Block {
+        int count;                                                  ///< Number of records
+        long long minTimestamp;                                     ///< Earliest timestamp
+        long long maxTimestamp;                                     ///< Latest timestamp
+        std::vector<unsigned char> timestamps;                      ///< Delta-of-delta encoded timestamps
+        unsigned char encodings[WindTempSolar::FIELD_COUNT];        ///< 0 for XOR, 1 + decimals for fixed point
+        std::vector<unsigned char> channels[WindTempSolar::FIELD_COUNT]; ///< Encoded float channels
+    };
+
+    /**
+     * @brief Encodes the pending records into a new block.
+     */
+    void sealBlock();
+
+    /**
+     * @brief Checks that a block read from a file decodes without overflow or out-of-range values.
+     *
+     * @param block The block.
+     * @return true if every timestamp lies within the block's range and every channel decodes, false otherwise.
+     */
+    static bool isValidBlock(const Block& block);
+
+    std::vector<Block> blocks;                                      /**< Compressed blocks. */
+    std::vector<long long> pendingTimestamps;                       /**< Timestamps not yet compressed. */
+    std::vector<float> pendingValues[WindTempSolar::FIELD_COUNT];   /**< Values not yet compressed. */
+    long long recordCount;                                          /**< Number of records in blocks. */
+};
+
+#endif // COMPRESSEDSERIES_H
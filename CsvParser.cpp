@@ -0,0 +1,110 @@
+#include "CsvParser.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+// Skips spaces and tabs
+const char* skipBlanks(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    return p;
+}
+
+// Parses an integer followed by the expected separator
+bool parseField(const char*& p, const char* end, int& value, char separator) {
+    p = skipBlanks(p, end);
+    std::from_chars_result result = std::from_chars(p, end, value);
+    if (result.ec != std::errc() || result.ptr >= end || *result.ptr != separator) return false;
+    p = result.ptr + 1;
+    return true;
+}
+
+// Checks whether a field holds a "not available" marker such as N/A, NA, NaN or -
+bool isMissingMarker(const char* p, const char* end) {
+    static const char* const MARKERS[] = { "n/a", "na", "nan", "-" };
+    while (end > p && (end[-1] == ' ' || end[-1] == '\t')) --end;
+    size_t length = end - p;
+    for (size_t m = 0; m < sizeof(MARKERS) / sizeof(MARKERS[0]); ++m) {
+        if (std::strlen(MARKERS[m]) != length) continue;
+        size_t i = 0;
+        while (i < length && (p[i] | 0x20) == MARKERS[m][i]) ++i;
+        if (i == length) return true;
+    }
+    return false;
+}
+
+// Parses a float followed by a comma, or by the end of the row for the last field.
+// Blank fields, missing markers and sentinel values give NaN and set valid to false.
+bool parseField(const char*& p, const char* end, float& value, bool last, bool& valid) {
+    p = skipBlanks(p, end);
+    const char* fieldEnd = (const char*)std::memchr(p, ',', end - p);
+    if (!fieldEnd) {
+        if (!last) return false;
+        fieldEnd = end;
+    }
+    std::from_chars_result result = std::from_chars(p, fieldEnd, value);
+    if (result.ec == std::errc() && skipBlanks(result.ptr, fieldEnd) == fieldEnd) {
+        valid = !std::isnan(value) && !CsvParser::isSentinel(value);
+    } else if (skipBlanks(p, fieldEnd) == fieldEnd || isMissingMarker(p, fieldEnd)) {
+        valid = false;
+    } else {
+        return false;
+    }
+    if (!valid) value = std::numeric_limits<float>::quiet_NaN();
+    p = (fieldEnd < end) ? fieldEnd + 1 : end;
+    return true;
+}
+}
+
+// Parses one row into a record
+bool CsvParser::parseLine(const char* begin, const char* end, WindTempSolar& record, size_t* invalidValues) {
+    if (end > begin && end[-1] == '\r') --end;
+    int day, month, year, hour, minute;
+    float values[WindTempSolar::FIELD_COUNT];
+    bool valid[WindTempSolar::FIELD_COUNT];
+    const char* p = begin;
+    if (!parseField(p, end, day, '/') || !parseField(p, end, month, '/') || !parseField(p, end, year, ',')
+        || !parseField(p, end, hour, ':') || !parseField(p, end, minute, ',')) {
+        return false;
+    }
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+        if (!parseField(p, end, values[f], f == WindTempSolar::FIELD_COUNT - 1, valid[f])) return false;
+    }
+    if (invalidValues) {
+        for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) invalidValues[f] += valid[f] ? 0 : 1;
+    }
+    record = WindTempSolar(Date(day, month, year), Time(hour, minute), values[0], values[1], values[2]);
+    return true;
+}
+
+// Parses one row held in a string
+bool CsvParser::parseLine(const std::string& line, WindTempSolar& record, size_t* invalidValues) {
+    return parseLine(line.data(), line.data() + line.size(), record, invalidValues);
+}
+
+// Parses every row of a block
+size_t CsvParser::parseRows(const char* data, size_t size, std::vector<WindTempSolar>& records, size_t* invalidValues) {
+    size_t malformed = 0;
+    const char* end = data + size;
+    const char* line = data;
+    while (line < end) {
+        const char* newline = (const char*)std::memchr(line, '\n', end - line);
+        const char* lineEnd = newline ? newline : end;
+        if (skipBlanks(line, lineEnd) < lineEnd && !(lineEnd - line == 1 && *line == '\r')) {
+            WindTempSolar record;
+            if (parseLine(line, lineEnd, record, invalidValues)) {
+                records.push_back(record);
+            } else {
+                malformed++;
+            }
+        }
+        line = lineEnd + 1;
+    }
+    return malformed;
+}
+
+// Checks a parsed value against the sentinels written by the loggers
+bool CsvParser::isSentinel(float value) {
+    return value == -9999.0f || value == -999.0f || value == 9999.0f || value == 6999.0f;
+}
@@ -0,0 +1,68 @@
+#ifndef CSVPARSER_H
+#define CSVPARSER_H
+
+#include "WindTempSolar.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Parser for the rows of the weather data files.
+ *
+ * A row has the form "d/m/yyyy,hh:mm,wind_speed,temperature,solar_radiation". Fields are
+ * parsed in place with std::from_chars, without building strings or streams per row.
+ *
+ * Values are validated as they are parsed: a blank value, a "not available" marker (N/A, NA,
+ * NaN or -, in any case) or a logger sentinel (see isSentinel) is stored as NaN and counted
+ * as invalid for its field, so it is excluded from the statistics instead of skewing them.
+ * Only rows whose date or time cannot be read, or whose values are neither numbers nor
+ * markers, are malformed.
+ */
+class CsvParser {
+public:
+    /**
+     * @brief Parses a single row.
+     *
+     * @param begin The first character of the row.
+     * @param end One past the last character of the row (a trailing '\r' is allowed).
+     * @param record Receives the parsed record.
+     * @param invalidValues If not null, an array of WindTempSolar::FIELD_COUNT counters incremented for each invalid value.
+     * @return true if the row was parsed, false if it is malformed.
+     */
+    static bool parseLine(const char* begin, const char* end, WindTempSolar& record, size_t* invalidValues = nullptr);
+
+    /**
+     * @brief Parses a single row.
+     *
+     * @param line The row.
+     * @param record Receives the parsed record.
+     * @param invalidValues If not null, an array of WindTempSolar::FIELD_COUNT counters incremented for each invalid value.
+     * @return true if the row was parsed, false if it is malformed.
+     */
+    static bool parseLine(const std::string& line, WindTempSolar& record, size_t* invalidValues = nullptr);
+
+    /**
+     * @brief Parses a block of complete rows separated by newlines.
+     *
+     * Blank lines are ignored.
+     *
+     * @param data The first character of the block.
+     * @param size The number of characters in the block.
+     * @param records Receives the parsed records, appended in order.
+     * @param invalidValues If not null, an array of WindTempSolar::FIELD_COUNT counters incremented for each invalid value.
+     * @return The number of malformed rows that were skipped.
+     */
+    static size_t parseRows(const char* data, size_t size, std::vector<WindTempSolar>& records, size_t* invalidValues = nullptr);
+
+    /**
+     * @brief Checks whether a value is a sentinel written by a logger for a missing reading.
+     *
+     * The sentinels are -9999, -999, 9999 and 6999.
+     *
+     * @param value The parsed value.
+     * @return true if the value is a sentinel, false otherwise.
+     */
+    static bool isSentinel(float value);
+};
+
+#endif // CSVPARSER_H
@@ -1,87 +1,112 @@
-#include "Date.h"
-#include <sstream>
-
-// Constructors
-// Default constructor initializes date to January 1, 0 AD
-Date::Date() : day(0), month(0), year(0) {}
-
-// Parameterized constructor initializes date with specified values
-Date::Date(int day, int month, int year) : day(day), month(month), year(year) {}
-
-// Constructor parses a date string in the format "dd/mm/yyyy" and initializes the date
-Date::Date(const std::string& date_str) {
-    std::istringstream ss(date_str); // Create a string stream to parse the date string
-    char delimiter;
-    ss >> day >> delimiter >> month >> delimiter >> year; // Extract day, month, and year using delimiter '/'
-}
-
-// Getters and setters
-// Getter for day
-int Date::getDay() const {
-    return day;
-}
-
-// Setter for day
-void Date::setDay(int day) {
-    this->day = day;
-}
-
-// Getter for month
-int Date::getMonth() const {
-    return month;
-}
-
-// Setter for month
-void Date::setMonth(int month) {
-    this->month = month;
-}
-
-// Getter for year
-int Date::getYear() const {
-    return year;
-}
-
-// Setter for year
-void Date::setYear(int year) {
-    this->year = year;
-}
-
-// Comparison operators
-// Less than operator
-bool Date::operator<(const Date& other) const {
-    if (year < other.year)
-        return true;
-    else if (year == other.year && month < other.month)
-        return true;
-    else if (year == other.year && month == other.month && day < other.day)
-        return true;
-    return false;
-}
-
-// Greater than operator
-bool Date::operator>(const Date& other) const {
-    if (year > other.year)
-        return true;
-    else if (year == other.year && month > other.month)
-        return true;
-    else if (year == other.year && month == other.month && day > other.day)
-        return true;
-    return false;
-}
-
-// Equal to operator
-bool Date::operator==(const Date& other) const {
-    return (day == other.day && month == other.month && year == other.year);
-}
-
-// Convert date to string
-std::string Date::toString() const {
-    return std::to_string(day) + "/" + std::to_string(month) + "/" + std::to_string(year);
-}
-
-// Overload output operator <<
-// Output stream operator to print a Date object
-std::ostream& operator<<(std::ostream& os, const Date& date) {
-    os << date.toString();
-    return os;
-}
+#include "Date.h"
+#include <sstream>
+
+// Constructors
+// Default constructor initializes date to January 1, 0 AD
+Date::Date() : day(0), month(0), year(0) {}
+
+// Parameterized constructor initializes date with specified values
+Date::Date(int day, int month, int year) : day(day), month(month), year(year) {}
+
+// Constructor parses a date string in the format "dd/mm/yyyy" and initializes the date
+Date::Date(const std::string& date_str) {
+    std::istringstream ss(date_str); // Create a string stream to parse the date string
+    char delimiter;
+    ss >> day >> delimiter >> month >> delimiter >> year; // Extract day, month, and year using delimiter '/'
+}
+
+// Getters and setters
+// Getter for day
+int Date::getDay() const {
+    return day;
+}
+
+// Setter for day
+void Date::setDay(int day) {
+    this->day = day;
+}
+
+// Getter for month
+int Date::getMonth() const {
+    return month;
+}
+
+// Setter for month
+void Date::setMonth(int month) {
+    this->month = month;
+}
+
+// Getter for year
+int Date::getYear() const {
+    return year;
+}
+
+// Setter for year
+void Date::setYear(int year) {
+    this->year = year;
+}
+
+// Comparison operators
+// Less than operator
+bool Date::operator<(const Date& other) const {
+    if (year < other.year)
+        return true;
+    else if (year == other.year && month < other.month)
+        return true;
+    else if (year == other.year && month == other.month && day < other.day)
+        return true;
+    return false;
+}
+
+// Greater than operator
+bool Date::operator>(const Date& other) const {
+    if (year > other.year)
+        return true;
+    else if (year == other.year && month > other.month)
+        return true;
+    else if (year == other.year && month == other.month && day > other.day)
+        return true;
+    return false;
+}
+
+// Equal to operator
+bool Date::operator==(const Date& other) const {
+    return (day == other.day && month == other.month && year == other.year);
+}
+
+// Convert the date to days since 1 January 1970 (proleptic Gregorian calendar)
+long long Date::toDayNumber() const {
+    // Count years from March so the leap day is the last day of the year
+    long long y = year - (month <= 2 ? 1 : 0);
+    long long era = (y >= 0 ? y : y - 399) / 400;
+    long long yearOfEra = y - era * 400;
+    long long dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// Create a date from days since 1 January 1970
+Date Date::fromDayNumber(long long dayNumber) {
+    dayNumber += 719468;
+    long long era = (dayNumber >= 0 ? dayNumber : dayNumber - 146096) / 146097;
+    long long dayOfEra = dayNumber - era * 146097;
+    long long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    long long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    long long monthIndex = (5 * dayOfYear + 2) / 153;
+    int d = (int)(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+    int m = (int)(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+    int y = (int)(yearOfEra + era * 400 + (m <= 2 ? 1 : 0));
+    return Date(d, m, y);
+}
+
+// Convert date to string
+std::string Date::toString() const {
+    return std::to_string(day) + "/" + std::to_string(month) + "/" + std::to_string(year);
+}
+
+// Overload output operator <<
+// Output stream operator to print a Date object
+std::ostream& operator<<(std::ostream& os, const Date& date) {
+    os << date.toString();
+    return os;
+}
@@ -0,0 +1,78 @@
+#include "Histogram.h"
+#include <cmath>
+
+// Constructor creates an empty histogram; counts holds underflow, the bins and overflow
+Histogram::Histogram(float binWidth, int binCount, float origin)
+    : binWidth(binWidth), binCount(binCount), origin(origin), counts(binCount + 2, 0) {}
+
+// Adds a single value to its bin
+void Histogram::add(float value) {
+    if (std::isnan(value)) return;
+    addValues(&value, 1);
+}
+
+// Adds an array of values, computing bin slots with clamping instead of branches
+void Histogram::addValues(const float* values, size_t count) {
+    const float scale = 1.0f / binWidth;
+    const float lowest = -1.0f;
+    const float highest = (float)binCount;
+    long long* slots = counts.data();
+    for (size_t i = 0; i < count; ++i) {
+        float position = std::floor((values[i] - origin) * scale);
+        // NaN fails both comparisons and is sent to the underflow slot by the first clamp
+        position = (position >= lowest) ? position : lowest;
+        position = (position <= highest) ? position : highest;
+        slots[(int)position + 1] += (values[i] == values[i]) ? 1 : 0;
+    }
+}
+
+// Merges another histogram with the same layout
+bool Histogram::merge(const Histogram& other) {
+    if (other.binCount != binCount || other.binWidth != binWidth || other.origin != origin) {
+        return false;
+    }
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    return true;
+}
+
+// Returns the number of bins
+int Histogram::getBinCount() const {
+    return binCount;
+}
+
+// Returns the width of each bin
+float Histogram::getBinWidth() const {
+    return binWidth;
+}
+
+// Returns the lower edge of a bin
+float Histogram::getBinStart(int bin) const {
+    return origin + bin * binWidth;
+}
+
+// Returns the number of values in a bin
+long long Histogram::getCount(int bin) const {
+    if (bin < 0 || bin >= binCount) return 0;
+    return counts[bin + 1];
+}
+
+// Returns the number of values below the first bin
+long long Histogram::getUnderflow() const {
+    return counts.front();
+}
+
+// Returns the number of values at or above the end of the last bin
+long long Histogram::getOverflow() const {
+    return counts.back();
+}
+
+// Returns the total number of values
+long long Histogram::getTotal() const {
+    long long total = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        total += counts[i];
+    }
+    return total;
+}
@@ -0,0 +1,111 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Fixed-width histogram of float values.
+ *
+ * Bins cover [origin + i * binWidth, origin + (i + 1) * binWidth). Values below the first
+ * bin and above the last bin are counted separately as underflow and overflow. Histograms
+ * with the same layout can be merged, so per-month histograms can be combined.
+ */
+class Histogram {
+public:
+    /**
+     * @brief Constructs an empty histogram.
+     *
+     * @param binWidth The width of each bin.
+     * @param binCount The number of bins.
+     * @param origin The lower edge of the first bin.
+     */
+    Histogram(float binWidth = 1.0f, int binCount = 40, float origin = 0.0f);
+
+    /**
+     * @brief Adds a value to the histogram.
+     *
+     * NaN values are ignored.
+     *
+     * @param value The value to add.
+     */
+    void add(float value);
+
+    /**
+     * @brief Adds a contiguous array of values in a single pass.
+     *
+     * The bin index of each value is computed without branches, so the loop runs over a
+     * whole column at memory speed.
+     *
+     * @param values Pointer to the first value.
+     * @param count The number of values.
+     */
+    void addValues(const float* values, size_t count);
+
+    /**
+     * @brief Merges another histogram with the same layout into this one.
+     *
+     * @param other The histogram to merge.
+     * @return true if the histograms were merged, false if their layouts differ.
+     */
+    bool merge(const Histogram& other);
+
+    /**
+     * @brief Returns the number of bins.
+     *
+     * @return The number of bins.
+     */
+    int getBinCount() const;
+
+    /**
+     * @brief Returns the width of each bin.
+     *
+     * @return The bin width.
+     */
+    float getBinWidth() const;
+
+    /**
+     * @brief Returns the lower edge of a bin.
+     *
+     * @param bin The index of the bin.
+     * @return The lower edge of the bin.
+     */
+    float getBinStart(int bin) const;
+
+    /**
+     * @brief Returns the number of values in a bin.
+     *
+     * @param bin The index of the bin.
+     * @return The number of values in the bin, or 0 if the index is out of range.
+     */
+    long long getCount(int bin) const;
+
+    /**
+     * @brief Returns the number of values below the first bin.
+     *
+     * @return The underflow count.
+     */
+    long long getUnderflow() const;
+
+    /**
+     * @brief Returns the number of values at or above the end of the last bin.
+     *
+     * @return The overflow count.
+     */
+    long long getOverflow() const;
+
+    /**
+     * @brief Returns the total number of values, including underflow and overflow.
+     *
+     * @return The total number of values.
+     */
+    long long getTotal() const;
+
+private:
+    float binWidth;                 /**< Width of each bin. */
+    int binCount;                   /**< Number of bins. */
+    float origin;                   /**< Lower edge of the first bin. */
+    std::vector<long long> counts;  /**< Underflow, the bins, then overflow. */
+};
+
+#endif // HISTOGRAM_H
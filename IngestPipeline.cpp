@@ -0,0 +1,205 @@
+#include "IngestPipeline.h"
+#include "CsvParser.h"
+#include "Profiler.h"
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+namespace {
+// Waits between attempts on a queue: spins briefly, then yields, then sleeps for doubling intervals,
+// so a stage stalled on a slow neighbour (such as a reader waiting on the disk) does not hold a core
+class Backoff {
+public:
+    Backoff() : attempts(0), sleepMicroseconds(1) {}
+
+    void wait() {
+        ++attempts;
+        if (attempts <= SPIN_LIMIT) return;
+        if (attempts <= SPIN_LIMIT + YIELD_LIMIT) {
+            std::this_thread::yield();
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(sleepMicroseconds));
+        if (sleepMicroseconds < MAX_SLEEP_MICROSECONDS) sleepMicroseconds *= 2;
+    }
+
+private:
+    static const int SPIN_LIMIT = 64;
+    static const int YIELD_LIMIT = 64;
+    static const long MAX_SLEEP_MICROSECONDS = 1000;
+
+    int attempts;
+    long sleepMicroseconds;
+};
+
+// Pushes a value, backing off while the queue is full
+template <class T>
+void pushWaiting(SpscQueue<T>& queue, T& value) {
+    Backoff backoff;
+    while (!queue.tryPush(value)) backoff.wait();
+}
+
+// Pops a value, backing off while the queue is empty
+template <class T>
+void popWaiting(SpscQueue<T>& queue, T& value) {
+    Backoff backoff;
+    while (!queue.tryPop(value)) backoff.wait();
+}
+}
+
+// Constructor sets up a pipeline with the given stage sizes
+IngestPipeline::IngestPipeline(size_t parserCount, size_t chunkSize, size_t queueCapacity)
+    : parserCount(parserCount), chunkSize(chunkSize > 0 ? chunkSize : 1), queueCapacity(queueCapacity),
+      chunkCount(0), recordCount(0), malformedCount(0), invalidCounts() {
+    if (this->parserCount == 0) {
+        size_t threads = std::thread::hardware_concurrency();
+        this->parserCount = (threads > 2) ? threads - 2 : 1;
+    }
+}
+
+// Adds a file to load
+void IngestPipeline::addFile(const std::string& filename, int stationId) {
+    fileNames.push_back(filename);
+    fileStations.push_back(stationId);
+}
+
+// Runs the reader and parsers on their own threads and inserts on the calling thread
+void IngestPipeline::run(StationStore& stations) {
+    PROFILE_SCOPE("IngestPipeline::run");
+    toParsers.clear();
+    toInserter.clear();
+    for (size_t i = 0; i < parserCount; ++i) {
+        toParsers.push_back(std::unique_ptr<SpscQueue<Chunk> >(new SpscQueue<Chunk>(queueCapacity)));
+        toInserter.push_back(std::unique_ptr<SpscQueue<ParsedChunk> >(new SpscQueue<ParsedChunk>(queueCapacity)));
+    }
+    chunkCount = 0;
+    recordCount = 0;
+    malformedCount = 0;
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) invalidCounts[f] = 0;
+    errors.clear();
+
+    std::thread reader(&IngestPipeline::read, this);
+    std::vector<std::thread> parsers;
+    for (size_t i = 0; i < parserCount; ++i) {
+        parsers.push_back(std::thread(&IngestPipeline::parse, this, i));
+    }
+
+    // Take the chunks back in input order and insert their records
+    ParsedChunk parsed;
+    for (long long sequence = 0;; ++sequence) {
+        popWaiting(*toInserter[sequence % parserCount], parsed);
+        if (parsed.sequence < 0) break;
+        PROFILE_SCOPE("insert chunk");
+        for (size_t i = 0; i < parsed.records.size(); ++i) {
+            stations.add(parsed.stationId, parsed.records[i]);
+        }
+        recordCount += (long long)parsed.records.size();
+        malformedCount += (long long)parsed.malformed;
+        for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) invalidCounts[f] += (long long)parsed.invalid[f];
+    }
+
+    reader.join();
+    for (size_t i = 0; i < parsers.size(); ++i) {
+        parsers[i].join();
+    }
+}
+
+// Returns the number of records inserted
+long long IngestPipeline::getRecordCount() const {
+    return recordCount;
+}
+
+// Returns the number of malformed rows skipped
+long long IngestPipeline::getMalformedCount() const {
+    return malformedCount;
+}
+
+// Returns the number of invalid values of a field
+long long IngestPipeline::getInvalidCount(int fieldIndex) const {
+    if (fieldIndex < 0 || fieldIndex >= WindTempSolar::FIELD_COUNT) return 0;
+    return invalidCounts[fieldIndex];
+}
+
+// Returns the problems met while loading
+const std::vector<std::string>& IngestPipeline::getErrors() const {
+    return errors;
+}
+
+// Reads each file in chunks that end on a row boundary
+void IngestPipeline::read() {
+    std::vector<char> block(chunkSize);
+    for (size_t f = 0; f < fileNames.size(); ++f) {
+        PROFILE_SCOPE("read " + fileNames[f]);
+        std::ifstream file(fileNames[f].c_str(), std::ios::in | std::ios::binary);
+        if (!file.is_open()) {
+            errors.push_back("Unable to open file " + fileNames[f]);
+            continue;
+        }
+        std::string carry; // Partial row left over from the previous block
+        bool header = true;
+        while (file) {
+            file.read(block.data(), (std::streamsize)block.size());
+            size_t got = (size_t)file.gcount();
+            if (got == 0) break;
+            PROFILE_COUNT("bytes read", got);
+            carry.append(block.data(), got);
+            if (header) {
+                // Drop the header line once it has been read completely
+                size_t newline = carry.find('\n');
+                if (newline == std::string::npos) continue;
+                carry.erase(0, newline + 1);
+                header = false;
+            }
+            size_t lastNewline = carry.rfind('\n');
+            if (lastNewline == std::string::npos) continue;
+            Chunk chunk;
+            chunk.stationId = fileStations[f];
+            chunk.text.assign(carry, 0, lastNewline + 1);
+            carry.erase(0, lastNewline + 1);
+            deal(chunk);
+        }
+        if (!header && !carry.empty()) {
+            Chunk chunk;
+            chunk.stationId = fileStations[f];
+            chunk.text.swap(carry);
+            deal(chunk);
+        }
+    }
+
+    // Tell every parser that the input has ended
+    for (size_t i = 0; i < parserCount; ++i) {
+        Chunk end;
+        end.sequence = -1;
+        end.stationId = 0;
+        pushWaiting(*toParsers[(chunkCount + i) % parserCount], end);
+    }
+}
+
+// Parses chunks until the end of the input
+void IngestPipeline::parse(size_t parser) {
+    Chunk chunk;
+    for (;;) {
+        popWaiting(*toParsers[parser], chunk);
+        ParsedChunk parsed;
+        parsed.sequence = chunk.sequence;
+        parsed.stationId = chunk.stationId;
+        parsed.malformed = 0;
+        for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) parsed.invalid[f] = 0;
+        if (chunk.sequence >= 0) {
+            PROFILE_SCOPE("parse chunk");
+            parsed.records.reserve(chunk.text.size() / 32);
+            parsed.malformed = CsvParser::parseRows(chunk.text.data(), chunk.text.size(), parsed.records, parsed.invalid);
+            PROFILE_COUNT("rows parsed", parsed.records.size());
+            PROFILE_COUNT("malformed rows", parsed.malformed);
+        }
+        pushWaiting(*toInserter[parser], parsed);
+        if (chunk.sequence < 0) return;
+    }
+}
+
+// Deals a chunk to the next parser in turn
+void IngestPipeline::deal(Chunk& chunk) {
+    chunk.sequence = chunkCount;
+    pushWaiting(*toParsers[chunkCount % parserCount], chunk);
+    chunkCount++;
+}
@@ -0,0 +1,129 @@
+#ifndef INGESTPIPELINE_H
+#define INGESTPIPELINE_H
+
+#include "StationStore.h"
+#include "SpscQueue.h"
+#include "WindTempSolar.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Staged loader that overlaps reading, parsing and inserting the data files.
+ *
+ * A reader thread reads the files in large chunks of whole rows. Chunks are dealt round-robin
+ * to a pool of parser threads, and the calling thread inserts the parsed records into the
+ * store. Stages are connected by bounded single-producer single-consumer lock-free queues.
+ * Because chunks are dealt round-robin, the inserter restores file order simply by taking
+ * chunk n from parser n % parserCount, so records are inserted in exactly the order of a
+ * sequential load.
+ */
+class IngestPipeline {
+public:
+    /**
+     * @brief Constructs a pipeline.
+     *
+     * @param parserCount The number of parser threads, or 0 to use the hardware threads left after the reader and inserter.
+     * @param chunkSize The number of bytes read per chunk.
+     * @param queueCapacity The number of chunks each queue can hold.
+     */
+    IngestPipeline(size_t parserCount = 0, size_t chunkSize = 1 << 20, size_t queueCapacity = 8);
+
+    /**
+     * @brief Adds a file to load. The first line of each file is a header and is skipped.
+     *
+     * @param filename The name of the file.
+     * @param stationId The station the records of the file belong to.
+     */
+    void addFile(const std::string& filename, int stationId);
+
+    /**
+     * @brief Loads all added files into the store and waits until they are inserted.
+     *
+     * @param stations The store to insert the records into.
+     */
+    void run(StationStore& stations);
+
+    /**
+     * @brief Returns the number of records inserted by run().
+     *
+     * @return The number of records.
+     */
+    long long getRecordCount() const;
+
+    /**
+     * @brief Returns the number of malformed rows skipped by run().
+     *
+     * @return The number of malformed rows.
+     */
+    long long getMalformedCount() const;
+
+    /**
+     * @brief Returns the number of values of a field that run() found invalid and stored as NaN.
+     *
+     * @param fieldIndex The index of the field (see WindTempSolar::getValue).
+     * @return The number of invalid values, or 0 if the index is out of range.
+     */
+    long long getInvalidCount(int fieldIndex) const;
+
+    /**
+     * @brief Returns the problems met by run(), such as files that could not be opened.
+     *
+     * @return The error messages, in file order.
+     */
+    const std::vector<std::string>& getErrors() const;
+
+private:
+    /**
+     * @brief Rows of one file passed from the reader to a parser.
+     */
+    struct Chunk {
+        long long sequence;     ///< Position of the chunk in the input, or -1 at the end of the input
+        int stationId;          ///< Station of the file the rows come from
+        std::string text;       ///< Whole rows separated by newlines
+    };
+
+    /**
+     * @brief Records of one chunk passed from a parser to the inserter.
+     */
+    struct ParsedChunk {
+        long long sequence;                 ///< Position of the chunk in the input, or -1 at the end of the input
+        int stationId;                      ///< Station of the records
+        std::vector<WindTempSolar> records; ///< Records in file order
+        size_t malformed;                   ///< Number of malformed rows skipped
+        size_t invalid[WindTempSolar::FIELD_COUNT]; ///< Number of invalid values of each field
+    };
+
+    /**
+     * @brief Reads the files and deals their chunks to the parsers.
+     */
+    void read();
+
+    /**
+     * @brief Parses the chunks of one parser's queue.
+     * @param parser The index of the parser.
+     */
+    void parse(size_t parser);
+
+    /**
+     * @brief Passes a chunk to the parser whose turn it is.
+     * @param chunk The chunk.
+     */
+    void deal(Chunk& chunk);
+
+    size_t parserCount;                                             /**< Number of parser threads. */
+    size_t chunkSize;                                               /**< Bytes read per chunk. */
+    size_t queueCapacity;                                           /**< Chunks each queue can hold. */
+    std::vector<std::string> fileNames;                             /**< Files to load. */
+    std::vector<int> fileStations;                                  /**< Station of each file. */
+    std::vector<std::unique_ptr<SpscQueue<Chunk> > > toParsers;     /**< Reader to parser queues. */
+    std::vector<std::unique_ptr<SpscQueue<ParsedChunk> > > toInserter; /**< Parser to inserter queues. */
+    long long chunkCount;                                           /**< Chunks dealt so far. */
+    long long recordCount;                                          /**< Records inserted. */
+    long long malformedCount;                                       /**< Malformed rows skipped. */
+    long long invalidCounts[WindTempSolar::FIELD_COUNT];            /**< Invalid values of each field. */
+    std::vector<std::string> errors;                                /**< Problems met while reading. */
+};
+
+#endif // INGESTPIPELINE_H
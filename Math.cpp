@@ -1,160 +1,367 @@
-#include "Math.h"
-
-// Calculates and returns the average wind speed for the specified month and year.
-float Math::calculateAverageWindSpeed(const Vector<WindTempSolar>& data, int month, int year) {
-    float sum = 0;
-    int count = 0;
-    // Iterate over the data vector to calculate the sum and count of wind speeds
-    for (int i = 0; i < data.size(); ++i) {
-        const WindTempSolar& record = data[i];
-        // Check if the record's date matches the specified month and year
-        if (record.getDate().getMonth() == month && record.getDate().getYear() == year) {
-            sum += record.getWindSpeed();
-            count++;
-        }
-    }
-    // Return the average wind speed or 0 if no records were found
-    return (count > 0) ? sum / count : 0;
-}
-
-
-// Calculates and returns the standard deviation of wind speed for the specified month and year.
-float Math::calculateStandardDeviation(const Vector<WindTempSolar>& data, int month, int year) {
-    float mean = calculateAverageWindSpeed(data, month, year);
-    float sumSquaredDiff = 0;
-    int count = 0;
-    // Iterate over the data vector to calculate the sum of squared differences
-    for (int i = 0; i < data.size(); ++i) {
-        const WindTempSolar& record = data[i];
-        // Check if the record's date matches the specified month and year
-        if (record.getDate().getMonth() == month && record.getDate().getYear() == year) {
-            sumSquaredDiff += pow(record.getWindSpeed() - mean, 2);
-            count++;
-        }
-    }
-    // Calculate the variance and return the standard deviation
-    float variance = (count > 0) ? sumSquaredDiff / count : 0;
-    return sqrt(variance);
-}
-
-// Calculates and returns the average ambient air temperature for the specified month and year.
-float Math::calculateAverageAmbientTemperature(const Vector<WindTempSolar>& data, int month, int year) {
-    float sum = 0;
-    int count = 0;
-    // Iterate over the data vector to calculate the sum and count of temperatures
-    for (int i = 0; i < data.size(); ++i) {
-        const WindTempSolar& record = data[i];
-        // Check if the record's date matches the specified month and year
-        if (record.getDate().getMonth() == month && record.getDate().getYear() == year) {
-            sum += record.getTemperature();
-            count++;
-        }
-    }
-    // Return the average temperature or 0 if no records were found
-    return (count > 0) ? sum / count : 0;
-}
-
-// Calculates and returns the total solar radiation for the specified month and year.
-float Math::calculateTotalSolarRadiation(const Vector<WindTempSolar>& data, int month, int year) {
-    float total = 0;
-    // Iterate over the data vector to calculate the total solar radiation
-    for (int i = 0; i < data.size(); ++i) {
-        const WindTempSolar& record = data[i];
-        // Check if the record's date matches the specified month and year
-        if (record.getDate().getMonth() == month && record.getDate().getYear() == year) {
-            total += record.getSolarRadiation();
-        }
-    }
-    // Return the total solar radiation
-    return total;
-}
-
-// Calculates and returns the mean absolute deviation of wind speed for the specified month and year.
-float Math::calculateWindSpeedMAD(const Vector<WindTempSolar>& data, int month, int year) {
-    float mean = calculateAverageWindSpeed(data, month, year);
-    float sumAbsoluteDifferences = 0;
-    int count = 0;
-    // Iterate over the data vector to calculate the sum of absolute differences
-    for (int i = 0; i < data.size(); ++i) {
-        const WindTempSolar& record = data[i];
-        // Check if the record's date matches the specified month and year
-        if (record.getDate().getMonth() == month && record.getDate().getYear() == year) {
-            sumAbsoluteDifferences += std::abs(record.getWindSpeed() - mean);
-            count++;
-        }
-    }
-    // Return the mean absolute deviation or 0 if no records were found
-    return (count > 0) ? sumAbsoluteDifferences / count : 0;
-}
-
-// Calculates and returns the mean absolute deviation of temperature for the specified month and year.
-float Math::calculateTemperatureMAD(const Vector<WindTempSolar>& data, int month, int year) {
-    float mean = calculateAverageAmbientTemperature(data, month, year);
-    float sumAbsoluteDifferences = 0;
-    int count = 0;
-    // Iterate over the data vector to calculate the sum of absolute differences
-    for (int i = 0; i < data.size(); ++i) {
-        const WindTempSolar& record = data[i];
-        // Check if the record's date matches the specified month and year
-        if (record.getDate().getMonth() == month && record.getDate().getYear() == year) {
-            sumAbsoluteDifferences += std::abs(record.getTemperature() - mean);
-            count++;
-        }
-    }
-    // Return the mean absolute deviation or 0 if no records were found
-    return (count > 0) ? sumAbsoluteDifferences / count : 0;
-}
-
-// Calculates and returns the sample Pearson correlation coefficient (SPCC) between two fields for the specified month.
-float Math::calculateSPCC(const Vector<WindTempSolar>& data, int month, const std::string& field1, const std::string& field2) {
-    // Initialize variables for summation
-    float sumField1 = 0;
-    float sumField2 = 0;
-    float sumField1Field2 = 0;
-    float sumField1Squared = 0;
-    float sumField2Squared = 0;
-    int count = 0;
-
-    // Iterate through the data vector
-    for (int i = 0; i < data.size(); ++i) {
-        const WindTempSolar& record = data[i];
-        // Check if the record's date matches the specified month
-        if (record.getDate().getMonth() == month) {
-            // Extract the values of the specified fields
-            float value1 = 0;
-            float value2 = 0;
-            if (field1 == "wind_speed") {
-                value1 = record.getWindSpeed();
-            } else if (field1 == "temperature") {
-                value1 = record.getTemperature();
-            } else if (field1 == "solar_radiation") {
-                value1 = record.getSolarRadiation();
-            }
-            if (field2 == "wind_speed") {
-                value2 = record.getWindSpeed();
-            } else if (field2 == "temperature") {
-                value2 = record.getTemperature();
-            } else if (field2 == "solar_radiation") {
-                value2 = record.getSolarRadiation();
-            }
-
-            // Update summation variables
-            sumField1 += value1;
-            sumField2 += value2;
-            sumField1Field2 += value1 * value2;
-            sumField1Squared += value1 * value1;
-            sumField2Squared += value2 * value2;
-            count++;
-        }
-    }
-
-    // Check if no records were found for the specified month
-    if (count == 0) return 0;
-
-    // Calculate the numerator and denominator of the correlation coefficient formula
-    float numerator = count * sumField1Field2 - sumField1 * sumField2;
-    float denominator = std::sqrt((count * sumField1Squared - sumField1 * sumField1) * (count * sumField2Squared - sumField2 * sumField2));
-
-    // Calculate and return the correlation coefficient (avoid division by zero)
-    return (denominator != 0) ? numerator / denominator : 0;
-}
+#include "Math.h"
+#include "QuerySpec.h"
+#include "ValidityMask.h"
+#include "Profiler.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+// Calls visit(value) for every value of the field whose timestamp lies in the month,
+// decoding only the blocks whose time range overlaps the month
+template <class Visitor>
+void visitCompressedMonth(const CompressedSeries& data, const std::string& field, int month, int year, Visitor& visit) {
+    int fieldIndex = WindTempSolar::getFieldIndex(field);
+    if (fieldIndex < 0) return;
+    long long start, end;
+    QuerySpec(QuerySpec::MEAN, field, month, year).getTimeRange(start, end);
+    std::vector<long long> timestamps;
+    std::vector<float> values;
+    for (int b = 0; b < data.getBlockCount(); ++b) {
+        if (data.getBlockMaxTimestamp(b) < start || data.getBlockMinTimestamp(b) >= end) continue;
+        data.decodeTimestamps(b, timestamps);
+        data.decodeChannel(b, fieldIndex, values);
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (timestamps[i] >= start && timestamps[i] < end) visit(values[i]);
+        }
+    }
+}
+
+// Accumulates count, sum and sum of squares
+struct SumVisitor {
+    long long count;
+    double sum;
+    double sumSquares;
+    SumVisitor() : count(0), sum(0), sumSquares(0) {}
+    void operator()(float value) {
+        if (std::isnan(value)) return; // Invalid values are left out
+        count++;
+        sum += value;
+        sumSquares += (double)value * value;
+    }
+};
+
+const int WORD_BITS = ValidityMask::WORD_BITS;
+static_assert(ZoneMap::BLOCK_SIZE % ValidityMask::WORD_BITS == 0, "zone map blocks must be whole bitmap words");
+
+// Returns the mask with the low n bits set
+inline uint64_t lowBits(int n) {
+    return (n >= WORD_BITS) ? ~(uint64_t)0 : (((uint64_t)1 << n) - 1);
+}
+
+// Derives the validity bits of n values from the values themselves (NaN compares unequal)
+inline uint64_t validBits(const float* values, int n) {
+    uint64_t bits = 0;
+    for (int j = 0; j < n; ++j) bits |= (uint64_t)(values[j] == values[j]) << j;
+    return bits;
+}
+
+// Runs a kernel over the data one word of 64 records at a time. The values of the two fields
+// are copied to contiguous arrays for the records of the month, and the mask passed to the kernel is the month filter ANDed
+// with the validity of both fields, taken from the bitmaps when given and from the values
+// otherwise. Words with no selected record are skipped.
+template <class Kernel>
+void forEachMonthWord(const Vector<WindTempSolar>& data, int field1, int field2, const ValidityMask* valid1,
+                      const ValidityMask* valid2, int month, int year, Kernel& kernel) {
+    PROFILE_SCOPE("Math month scan");
+    // Slots of unselected records keep stale values, which the masks never select
+    float values1[WORD_BITS] = {};
+    float values2[WORD_BITS] = {};
+    bool pair = (field2 != field1);
+    int size = data.size();
+    for (int base = 0; base < size; base += WORD_BITS) {
+        int n = (size - base < WORD_BITS) ? size - base : WORD_BITS;
+        uint64_t filter = 0;
+        for (int j = 0; j < n; ++j) {
+            const WindTempSolar& record = data[base + j];
+            Date date = record.getDate();
+            // The year is only compared for single-year queries
+            bool selected = (date.getMonth() == month) && (year == 0 || date.getYear() == year);
+            filter |= (uint64_t)selected << j;
+            if (!selected) continue;
+            values1[j] = record.getValue(field1);
+            if (pair) values2[j] = record.getValue(field2);
+        }
+        if (filter == 0) continue;
+        size_t word = (size_t)base / WORD_BITS;
+        uint64_t mask = filter;
+        mask &= valid1 ? valid1->getWord(word) : validBits(values1, n);
+        if (pair) mask &= valid2 ? valid2->getWord(word) : validBits(values2, n);
+        kernel(values1, pair ? values2 : values1, mask, n);
+    }
+}
+
+// Sums the selected values, with an unmasked loop when every value of the word is selected
+struct MaskedSumKernel {
+    long long count;
+    double sum;
+    MaskedSumKernel() : count(0), sum(0) {}
+    void operator()(const float* values, const float*, uint64_t mask, int n) {
+        count += ValidityMask::countBits(mask);
+        double partial = 0;
+        if (mask == lowBits(n)) {
+            for (int j = 0; j < n; ++j) partial += values[j];
+        } else {
+            // Unselected values (possibly NaN) are replaced by 0 with a select, not a branch
+            for (int j = 0; j < n; ++j) partial += ((mask >> j) & 1) ? (double)values[j] : 0.0;
+        }
+        sum += partial;
+    }
+};
+
+// Sums the squared and absolute differences of the selected values from a mean
+struct MaskedDeviationKernel {
+    double mean;
+    double sumSquares;
+    double sumAbsolute;
+    MaskedDeviationKernel(double mean) : mean(mean), sumSquares(0), sumAbsolute(0) {}
+    void operator()(const float* values, const float*, uint64_t mask, int n) {
+        double squares = 0;
+        double absolute = 0;
+        for (int j = 0; j < n; ++j) {
+            double difference = ((mask >> j) & 1) ? values[j] - mean : 0.0;
+            squares += difference * difference;
+            absolute += std::abs(difference);
+        }
+        sumSquares += squares;
+        sumAbsolute += absolute;
+    }
+};
+
+// Accumulates the sums of the SPCC formula over the records where both values are selected
+struct MaskedPairKernel {
+    long long count;
+    double sum1, sum2, sumProducts, sumSquares1, sumSquares2;
+    MaskedPairKernel() : count(0), sum1(0), sum2(0), sumProducts(0), sumSquares1(0), sumSquares2(0) {}
+    void operator()(const float* values1, const float* values2, uint64_t mask, int n) {
+        count += ValidityMask::countBits(mask);
+        for (int j = 0; j < n; ++j) {
+            bool selected = (mask >> j) & 1;
+            double value1 = selected ? values1[j] : 0.0;
+            double value2 = selected ? values2[j] : 0.0;
+            sum1 += value1;
+            sum2 += value2;
+            sumProducts += value1 * value2;
+            sumSquares1 += value1 * value1;
+            sumSquares2 += value2 * value2;
+        }
+    }
+};
+
+// Mean of the selected values of a field
+float maskedMean(const Vector<WindTempSolar>& data, int field, const ValidityMask* valid, int month, int year) {
+    MaskedSumKernel sums;
+    forEachMonthWord(data, field, field, valid, valid, month, year, sums);
+    return (sums.count > 0) ? (float)(sums.sum / sums.count) : 0;
+}
+
+// Standard deviation (divisor n) or mean absolute deviation of the selected values of a field
+float maskedDeviation(const Vector<WindTempSolar>& data, int field, const ValidityMask* valid, int month, int year, bool absolute) {
+    MaskedSumKernel sums;
+    forEachMonthWord(data, field, field, valid, valid, month, year, sums);
+    if (sums.count == 0) return 0;
+    MaskedDeviationKernel deviations(sums.sum / sums.count);
+    forEachMonthWord(data, field, field, valid, valid, month, year, deviations);
+    if (absolute) return (float)(deviations.sumAbsolute / sums.count);
+    return (float)std::sqrt(deviations.sumSquares / sums.count);
+}
+
+// Total of the selected values of a field
+float maskedTotal(const Vector<WindTempSolar>& data, int field, const ValidityMask* valid, int month, int year) {
+    MaskedSumKernel sums;
+    forEachMonthWord(data, field, field, valid, valid, month, year, sums);
+    return (float)sums.sum;
+}
+
+// SPCC over the records of a month (all years) where both fields are valid
+float maskedCorrelation(const Vector<WindTempSolar>& data, int field1, int field2, const ValidityMask* valid1, const ValidityMask* valid2, int month) {
+    MaskedPairKernel sums;
+    forEachMonthWord(data, field1, field2, valid1, valid2, month, 0, sums);
+    if (sums.count == 0) return 0;
+    // Calculate the numerator and denominator of the correlation coefficient formula
+    double numerator = sums.count * sums.sumProducts - sums.sum1 * sums.sum2;
+    double denominator = std::sqrt((sums.count * sums.sumSquares1 - sums.sum1 * sums.sum1) * (sums.count * sums.sumSquares2 - sums.sum2 * sums.sum2));
+    return (denominator > 0) ? (float)(numerator / denominator) : 0;
+}
+
+// Accumulates absolute differences from a mean
+struct DeviationVisitor {
+    double mean;
+    double sum;
+    DeviationVisitor(double mean) : mean(mean), sum(0) {}
+    void operator()(float value) { if (!std::isnan(value)) sum += std::abs(value - mean); }
+};
+}
+
+// Calculates and returns the average wind speed for the specified month and year.
+float Math::calculateAverageWindSpeed(const Vector<WindTempSolar>& data, int month, int year) {
+    return maskedMean(data, 0, nullptr, month, year);
+}
+
+// Calculates and returns the standard deviation of wind speed for the specified month and year.
+float Math::calculateStandardDeviation(const Vector<WindTempSolar>& data, int month, int year) {
+    return maskedDeviation(data, 0, nullptr, month, year, false);
+}
+
+// Calculates and returns the average ambient air temperature for the specified month and year.
+float Math::calculateAverageAmbientTemperature(const Vector<WindTempSolar>& data, int month, int year) {
+    return maskedMean(data, 1, nullptr, month, year);
+}
+
+// Calculates and returns the total solar radiation for the specified month and year.
+float Math::calculateTotalSolarRadiation(const Vector<WindTempSolar>& data, int month, int year) {
+    return maskedTotal(data, 2, nullptr, month, year);
+}
+
+// Calculates and returns the mean absolute deviation of wind speed for the specified month and year.
+float Math::calculateWindSpeedMAD(const Vector<WindTempSolar>& data, int month, int year) {
+    return maskedDeviation(data, 0, nullptr, month, year, true);
+}
+
+// Calculates and returns the mean absolute deviation of temperature for the specified month and year.
+float Math::calculateTemperatureMAD(const Vector<WindTempSolar>& data, int month, int year) {
+    return maskedDeviation(data, 1, nullptr, month, year, true);
+}
+
+// Calculates and returns the sample Pearson correlation coefficient (SPCC) between two fields for the specified month.
+float Math::calculateSPCC(const Vector<WindTempSolar>& data, int month, const std::string& field1, const std::string& field2) {
+    int f1 = WindTempSolar::getFieldIndex(field1);
+    int f2 = WindTempSolar::getFieldIndex(field2);
+    if (f1 < 0 || f2 < 0) return 0;
+    return maskedCorrelation(data, f1, f2, nullptr, nullptr, month);
+}
+
+// Calculates and returns the average of a field for the specified month and year using the store's validity bitmaps.
+float Math::calculateAverage(const RecordStore& store, const std::string& field, int month, int year) {
+    int f = WindTempSolar::getFieldIndex(field);
+    if (f < 0) return 0;
+    return maskedMean(store.getRecords(), f, &store.getValidity(f), month, year);
+}
+
+// Calculates and returns the standard deviation of a field for the specified month and year using the store's validity bitmaps.
+float Math::calculateStandardDeviation(const RecordStore& store, const std::string& field, int month, int year) {
+    int f = WindTempSolar::getFieldIndex(field);
+    if (f < 0) return 0;
+    return maskedDeviation(store.getRecords(), f, &store.getValidity(f), month, year, false);
+}
+
+// Calculates and returns the total of a field for the specified month and year using the store's validity bitmaps.
+float Math::calculateTotal(const RecordStore& store, const std::string& field, int month, int year) {
+    int f = WindTempSolar::getFieldIndex(field);
+    if (f < 0) return 0;
+    return maskedTotal(store.getRecords(), f, &store.getValidity(f), month, year);
+}
+
+// Calculates and returns the mean absolute deviation of a field for the specified month and year using the store's validity bitmaps.
+float Math::calculateMAD(const RecordStore& store, const std::string& field, int month, int year) {
+    int f = WindTempSolar::getFieldIndex(field);
+    if (f < 0) return 0;
+    return maskedDeviation(store.getRecords(), f, &store.getValidity(f), month, year, true);
+}
+
+// Calculates and returns the SPCC between two fields for the specified month using the store's validity bitmaps.
+float Math::calculateSPCC(const RecordStore& store, int month, const std::string& field1, const std::string& field2) {
+    int f1 = WindTempSolar::getFieldIndex(field1);
+    int f2 = WindTempSolar::getFieldIndex(field2);
+    if (f1 < 0 || f2 < 0) return 0;
+    return maskedCorrelation(store.getRecords(), f1, f2, &store.getValidity(f1), &store.getValidity(f2), month);
+}
+
+// Calculates and returns the average of a field over a time window, skipping blocks outside it.
+float Math::calculateAverage(const RecordStore& store, const ZoneMap& zones, const std::string& field, long long start, long long end) {
+    int fieldIndex = WindTempSolar::getFieldIndex(field);
+    if (fieldIndex < 0) return 0;
+    const Vector<WindTempSolar>& data = store.getRecords();
+    const ValidityMask& valid = store.getValidity(fieldIndex);
+    double sum = 0;
+    long long count = 0;
+    float values[WORD_BITS] = {};
+    for (int b = 0; b < zones.getBlockCount(); ++b) {
+        if (!zones.overlapsTime(b, start, end)) continue;
+        int first = zones.getBlockBegin(b);
+        int last = zones.getBlockEnd(b);
+        if (zones.containedInTime(b, start, end) && !zones.hasInvalidValues(b, fieldIndex)) {
+            // Every record of the block is inside the window and valid
+            for (int i = first; i < last; ++i) sum += data[i].getValue(fieldIndex);
+            count += last - first;
+            continue;
+        }
+        // Zone map blocks are whole words of the bitmap, so each word is filtered by time and validity
+        for (int base = first; base < last; base += WORD_BITS) {
+            int n = (last - base < WORD_BITS) ? last - base : WORD_BITS;
+            uint64_t filter = 0;
+            for (int j = 0; j < n; ++j) {
+                long long timestamp = data[base + j].getTimestamp();
+                filter |= (uint64_t)(timestamp >= start && timestamp < end) << j;
+                values[j] = data[base + j].getValue(fieldIndex);
+            }
+            MaskedSumKernel sums;
+            sums(values, values, filter & valid.getWord((size_t)base / WORD_BITS), n);
+            sum += sums.sum;
+            count += sums.count;
+        }
+    }
+    return (count > 0) ? (float)(sum / count) : 0;
+}
+
+// Counts the records in a time window whose field lies in the value range, skipping blocks that cannot match.
+long long Math::countRecords(const Vector<WindTempSolar>& data, const ZoneMap& zones, const std::string& field, float minValue, float maxValue, long long start, long long end) {
+    int fieldIndex = WindTempSolar::getFieldIndex(field);
+    if (fieldIndex < 0) return 0;
+    long long count = 0;
+    for (int b = 0; b < zones.getBlockCount(); ++b) {
+        if (!zones.overlapsTime(b, start, end) || !zones.overlapsValues(b, fieldIndex, minValue, maxValue)) continue;
+        int first = zones.getBlockBegin(b);
+        int last = zones.getBlockEnd(b);
+        bool allInTime = zones.containedInTime(b, start, end);
+        if (allInTime && zones.containedInValues(b, fieldIndex, minValue, maxValue)) {
+            // Every record of the block matches
+            count += last - first;
+            continue;
+        }
+        for (int i = first; i < last; ++i) {
+            float value = data[i].getValue(fieldIndex);
+            // Written so that NaN values never match
+            if (!(value >= minValue && value <= maxValue)) continue;
+            if (!allInTime) {
+                long long timestamp = data[i].getTimestamp();
+                if (timestamp < start || timestamp >= end) continue;
+            }
+            count++;
+        }
+    }
+    return count;
+}
+
+// Calculates and returns the average of a field for the specified month and year from compressed data.
+float Math::calculateAverage(const CompressedSeries& data, const std::string& field, int month, int year) {
+    SumVisitor sums;
+    visitCompressedMonth(data, field, month, year, sums);
+    return (sums.count > 0) ? (float)(sums.sum / sums.count) : 0;
+}
+
+// Calculates and returns the standard deviation of a field for the specified month and year from compressed data.
+float Math::calculateStandardDeviation(const CompressedSeries& data, const std::string& field, int month, int year) {
+    SumVisitor sums;
+    visitCompressedMonth(data, field, month, year, sums);
+    if (sums.count == 0) return 0;
+    double mean = sums.sum / sums.count;
+    double variance = sums.sumSquares / sums.count - mean * mean;
+    return (variance > 0) ? (float)std::sqrt(variance) : 0;
+}
+
+// Calculates and returns the total of a field for the specified month and year from compressed data.
+float Math::calculateTotal(const CompressedSeries& data, const std::string& field, int month, int year) {
+    SumVisitor sums;
+    visitCompressedMonth(data, field, month, year, sums);
+    return (float)sums.sum;
+}
+
+// Calculates and returns the mean absolute deviation of a field for the specified month and year from compressed data.
+float Math::calculateMAD(const CompressedSeries& data, const std::string& field, int month, int year) {
+    SumVisitor sums;
+    visitCompressedMonth(data, field, month, year, sums);
+    if (sums.count == 0) return 0;
+    DeviationVisitor deviations(sums.sum / sums.count);
+    visitCompressedMonth(data, field, month, year, deviations);
+    return (float)(deviations.sum / sums.count);
+}
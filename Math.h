@@ -1,79 +1,217 @@
-#ifndef MATH_H
-#define MATH_H
-
-#include "Vector.h"
-#include "WindTempSolar.h"
-#include <cmath>
-#include <string>
-
-/**
- * @brief The Math class provides static methods for various calculations based on wind, temperature, and solar data.
- */
-class Math {
-public:
-    /**
-     * @brief Calculate and return the average wind speed for the specified month and year.
-     * @param data Vector of WindTempSolar objects containing the data.
-     * @param month The month for which to calculate the average wind speed.
-     * @param year The year for which to calculate the average wind speed.
-     * @return The average wind speed for the specified month and year.
-     */
-    static float calculateAverageWindSpeed(const Vector<WindTempSolar>& data, int month, int year);
-
-    /**
-     * @brief Calculate and return the standard deviation of wind speed for the specified month and year.
-     * @param data Vector of WindTempSolar objects containing the data.
-     * @param month The month for which to calculate the standard deviation of wind speed.
-     * @param year The year for which to calculate the standard deviation of wind speed.
-     * @return The standard deviation of wind speed for the specified month and year.
-     */
-    static float calculateStandardDeviation(const Vector<WindTempSolar>& data, int month, int year);
-
-    /**
-     * @brief Calculate and return the average ambient air temperature for the specified month and year.
-     * @param data Vector of WindTempSolar objects containing the data.
-     * @param month The month for which to calculate the average ambient air temperature.
-     * @param year The year for which to calculate the average ambient air temperature.
-     * @return The average ambient air temperature for the specified month and year.
-     */
-    static float calculateAverageAmbientTemperature(const Vector<WindTempSolar>& data, int month, int year);
-
-    /**
-     * @brief Calculate and return the total solar radiation for the specified month and year.
-     * @param data Vector of WindTempSolar objects containing the data.
-     * @param month The month for which to calculate the total solar radiation.
-     * @param year The year for which to calculate the total solar radiation.
-     * @return The total solar radiation for the specified month and year.
-     */
-    static float calculateTotalSolarRadiation(const Vector<WindTempSolar>& data, int month, int year);
-
-    /**
-     * @brief Calculate and return the mean absolute deviation of wind speed for the specified month and year.
-     * @param data Vector of WindTempSolar objects containing the data.
-     * @param month The month for which to calculate the mean absolute deviation of wind speed.
-     * @param year The year for which to calculate the mean absolute deviation of wind speed.
-     * @return The mean absolute deviation of wind speed for the specified month and year.
-     */
-    static float calculateWindSpeedMAD(const Vector<WindTempSolar>& data, int month, int year);
-
-    /**
-     * @brief Calculate and return the mean absolute deviation of temperature for the specified month and year.
-     * @param data Vector of WindTempSolar objects containing the data.
-     * @param month The month for which to calculate the mean absolute deviation of temperature.
-     * @param year The year for which to calculate the mean absolute deviation of temperature.
-     * @return The mean absolute deviation of temperature for the specified month and year.
-     */
-    static float calculateTemperatureMAD(const Vector<WindTempSolar>& data, int month, int year);
-
-    /**
-     * @brief Calculate and return the sample Pearson correlation coefficient (SPCC) between two fields for the specified month.
-     * @param data Vector of WindTempSolar objects containing the data.
-     * @param month The month for which to calculate the SPCC.
-     * @param field1 The field representing the first variable (e.g., "wind_speed").
-     * @param field2 The field representing the second variable (e.g., "temperature").
-     * @return The sample Pearson correlation coefficient (SPCC) between the two fields for the specified month.
-     */
-    static float calculateSPCC(const Vector<WindTempSolar>& data, int month, const std::string& field1, const std::string& field2);
-};
-
-#endif // MATH_H
+#ifndef MATH_H
+#define MATH_H
+
+#include "Vector.h"
+#include "WindTempSolar.h"
+#include "CompressedSeries.h"
+#include "ZoneMap.h"
+#include "RecordStore.h"
+#include <cmath>
+#include <string>
+
+/**
+ * @brief The Math class provides static methods for various calculations based on wind, temperature, and solar data.
+ *
+ * The monthly kernels work on words of 64 records: a month filter mask is built for the word
+ * and ANDed with the validity bits of the fields, and the selected values are reduced with
+ * selects instead of a branch per record. Invalid (NaN) values are therefore left out, so the
+ * results stay exact when values are missing. The RecordStore overloads take the validity
+ * bits from the store's bitmaps; the Vector overloads derive them from the values.
+ */
+class Math {
+public:
+    /**
+     * @brief Calculate and return the average wind speed for the specified month and year.
+     * @param data Vector of WindTempSolar objects containing the data.
+     * @param month The month for which to calculate the average wind speed.
+     * @param year The year for which to calculate the average wind speed.
+     * @return The average wind speed for the specified month and year.
+     */
+    static float calculateAverageWindSpeed(const Vector<WindTempSolar>& data, int month, int year);
+
+    /**
+     * @brief Calculate and return the standard deviation of wind speed for the specified month and year.
+     * @param data Vector of WindTempSolar objects containing the data.
+     * @param month The month for which to calculate the standard deviation of wind speed.
+     * @param year The year for which to calculate the standard deviation of wind speed.
+     * @return The standard deviation of wind speed for the specified month and year.
+     */
+    static float calculateStandardDeviation(const Vector<WindTempSolar>& data, int month, int year);
+
+    /**
+     * @brief Calculate and return the average ambient air temperature for the specified month and year.
+     * @param data Vector of WindTempSolar objects containing the data.
+     * @param month The month for which to calculate the average ambient air temperature.
+     * @param year The year for which to calculate the average ambient air temperature.
+     * @return The average ambient air temperature for the specified month and year.
+     */
+    static float calculateAverageAmbientTemperature(const Vector<WindTempSolar>& data, int month, int year);
+
+    /**
+     * @brief Calculate and return the total solar radiation for the specified month and year.
+     * @param data Vector of WindTempSolar objects containing the data.
+     * @param month The month for which to calculate the total solar radiation.
+     * @param year The year for which to calculate the total solar radiation.
+     * @return The total solar radiation for the specified month and year.
+     */
+    static float calculateTotalSolarRadiation(const Vector<WindTempSolar>& data, int month, int year);
+
+    /**
+     * @brief Calculate and return the mean absolute deviation of wind speed for the specified month and year.
+     * @param data Vector of WindTempSolar objects containing the data.
+     * @param month The month for which to calculate the mean absolute deviation of wind speed.
+     * @param year The year for which to calculate the mean absolute deviation of wind speed.
+     * @return The mean absolute deviation of wind speed for the specified month and year.
+     */
+    static float calculateWindSpeedMAD(const Vector<WindTempSolar>& data, int month, int year);
+
+    /**
+     * @brief Calculate and return the mean absolute deviation of temperature for the specified month and year.
+     * @param data Vector of WindTempSolar objects containing the data.
+     * @param month The month for which to calculate the mean absolute deviation of temperature.
+     * @param year The year for which to calculate the mean absolute deviation of temperature.
+     * @return The mean absolute deviation of temperature for the specified month and year.
+     */
+    static float calculateTemperatureMAD(const Vector<WindTempSolar>& data, int month, int year);
+
+    /**
+     * @brief Calculate and return the sample Pearson correlation coefficient (SPCC) between two fields for the specified month.
+     * @param data Vector of WindTempSolar objects containing the data.
+     * @param month The month for which to calculate the SPCC.
+     * @param field1 The field representing the first variable (e.g., "wind_speed").
+     * @param field2 The field representing the second variable (e.g., "temperature").
+     * @return The sample Pearson correlation coefficient (SPCC) between the two fields for the specified month.
+     */
+    static float calculateSPCC(const Vector<WindTempSolar>& data, int month, const std::string& field1, const std::string& field2);
+
+    /**
+     * @brief Calculate and return the average of a field over a time window, skipping blocks with the zone map.
+     *
+     * Blocks whose time range lies outside the window are skipped; blocks entirely inside it are
+     * summed without checking each timestamp. In the other blocks a word of 64 records is
+     * selected by ANDing a time filter with the validity bitmap, so invalid values are left out
+     * without a NaN test per record.
+     *
+     * @param store Record store holding the data and its validity bitmaps.
+     * @param zones Zone map of the data, up to date with it.
+     * @param field The field to average (e.g., "wind_speed").
+     * @param start The start of the window in minutes since 1 January 1970.
+     * @param end The end of the window (exclusive).
+     * @return The average of the field over the window, or 0 if no records were found.
+     */
+    static float calculateAverage(const RecordStore& store, const ZoneMap& zones, const std::string& field, long long start, long long end);
+
+    /**
+     * @brief Count the records in a time window whose field lies in [minValue, maxValue].
+     *
+     * Blocks that cannot match the window or the value range are skipped, and blocks that match
+     * entirely are counted without looking at their records. For "wind_speed > 25", pass a
+     * minValue just above 25 and INFINITY as maxValue.
+     *
+     * @param data Vector of WindTempSolar objects containing the data.
+     * @param zones Zone map of the data, up to date with it.
+     * @param field The field to test (e.g., "wind_speed").
+     * @param minValue The lowest accepted value.
+     * @param maxValue The highest accepted value.
+     * @param start The start of the window in minutes since 1 January 1970.
+     * @param end The end of the window (exclusive).
+     * @return The number of matching records.
+     */
+    static long long countRecords(const Vector<WindTempSolar>& data, const ZoneMap& zones, const std::string& field, float minValue, float maxValue, long long start, long long end);
+
+    /**
+     * @brief Calculate and return the average of a field for the specified month and year from compressed data.
+     *
+     * Blocks whose time range lies outside the month are skipped without being decoded, and only the
+     * timestamp column and the requested field are decoded for the others.
+     *
+     * @param data Compressed series of WindTempSolar records.
+     * @param field The field to average (e.g., "wind_speed").
+     * @param month The month for which to calculate the average.
+     * @param year The year for which to calculate the average.
+     * @return The average of the field for the specified month and year.
+     */
+    static float calculateAverage(const CompressedSeries& data, const std::string& field, int month, int year);
+
+    /**
+     * @brief Calculate and return the standard deviation of a field for the specified month and year from compressed data.
+     * @param data Compressed series of WindTempSolar records.
+     * @param field The field (e.g., "wind_speed").
+     * @param month The month for which to calculate the standard deviation.
+     * @param year The year for which to calculate the standard deviation.
+     * @return The standard deviation of the field for the specified month and year.
+     */
+    static float calculateStandardDeviation(const CompressedSeries& data, const std::string& field, int month, int year);
+
+    /**
+     * @brief Calculate and return the total of a field for the specified month and year from compressed data.
+     * @param data Compressed series of WindTempSolar records.
+     * @param field The field (e.g., "solar_radiation").
+     * @param month The month for which to calculate the total.
+     * @param year The year for which to calculate the total.
+     * @return The total of the field for the specified month and year.
+     */
+    static float calculateTotal(const CompressedSeries& data, const std::string& field, int month, int year);
+
+    /**
+     * @brief Calculate and return the mean absolute deviation of a field for the specified month and year from compressed data.
+     * @param data Compressed series of WindTempSolar records.
+     * @param field The field (e.g., "temperature").
+     * @param month The month for which to calculate the mean absolute deviation.
+     * @param year The year for which to calculate the mean absolute deviation.
+     * @return The mean absolute deviation of the field for the specified month and year.
+     */
+    static float calculateMAD(const CompressedSeries& data, const std::string& field, int month, int year);
+
+    /**
+     * @brief Calculate and return the average of a field for the specified month and year, skipping invalid values.
+     * @param store Record store whose validity bitmaps mask out the invalid values.
+     * @param field The field to average (e.g., "wind_speed").
+     * @param month The month for which to calculate the average.
+     * @param year The year for which to calculate the average, or 0 for the month across all years.
+     * @return The average of the valid values, or 0 if there are none.
+     */
+    static float calculateAverage(const RecordStore& store, const std::string& field, int month, int year);
+
+    /**
+     * @brief Calculate and return the standard deviation of a field for the specified month and year, skipping invalid values.
+     * @param store Record store whose validity bitmaps mask out the invalid values.
+     * @param field The field (e.g., "wind_speed").
+     * @param month The month for which to calculate the standard deviation.
+     * @param year The year for which to calculate the standard deviation, or 0 for the month across all years.
+     * @return The standard deviation of the valid values, or 0 if there are none.
+     */
+    static float calculateStandardDeviation(const RecordStore& store, const std::string& field, int month, int year);
+
+    /**
+     * @brief Calculate and return the total of a field for the specified month and year, skipping invalid values.
+     * @param store Record store whose validity bitmaps mask out the invalid values.
+     * @param field The field (e.g., "solar_radiation").
+     * @param month The month for which to calculate the total.
+     * @param year The year for which to calculate the total, or 0 for the month across all years.
+     * @return The total of the valid values.
+     */
+    static float calculateTotal(const RecordStore& store, const std::string& field, int month, int year);
+
+    /**
+     * @brief Calculate and return the mean absolute deviation of a field for the specified month and year, skipping invalid values.
+     * @param store Record store whose validity bitmaps mask out the invalid values.
+     * @param field The field (e.g., "temperature").
+     * @param month The month for which to calculate the mean absolute deviation.
+     * @param year The year for which to calculate the mean absolute deviation, or 0 for the month across all years.
+     * @return The mean absolute deviation of the valid values, or 0 if there are none.
+     */
+    static float calculateMAD(const RecordStore& store, const std::string& field, int month, int year);
+
+    /**
+     * @brief Calculate and return the SPCC between two fields for the specified month over the records where both are valid.
+     * @param store Record store whose validity bitmaps mask out the invalid values.
+     * @param month The month for which to calculate the SPCC.
+     * @param field1 The first field for correlation.
+     * @param field2 The second field for correlation.
+     * @return The sample Pearson correlation coefficient, or 0 if it is undefined.
+     */
+    static float calculateSPCC(const RecordStore& store, int month, const std::string& field1, const std::string& field2);
+};
+
+#endif // MATH_H
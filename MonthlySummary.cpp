@@ -0,0 +1,219 @@
+#include "MonthlySummary.h"
+#include <cmath>
+
+namespace {
+// The fields of each pair, in the order of getPairIndex
+const int PAIR_FIELDS[3][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+}
+
+// Default constructor creates an empty summary
+MonthlySummary::MonthlySummary() : count(0), gapCount(0), missingSamples(0), duplicateCount(0) {
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+        validCount[f] = 0;
+        sum[f] = 0;
+        sumSquares[f] = 0;
+        min[f] = 0;
+        max[f] = 0;
+        pairCount[f] = 0;
+        pairSum[f][0] = pairSum[f][1] = 0;
+        pairSumSquares[f][0] = pairSumSquares[f][1] = 0;
+        sumProducts[f] = 0;
+    }
+}
+
+// Adds a single record to the running sums, skipping its invalid values
+void MonthlySummary::add(const WindTempSolar& record) {
+    float values[WindTempSolar::FIELD_COUNT];
+    bool valid[WindTempSolar::FIELD_COUNT];
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+        values[f] = record.getValue(f);
+        valid[f] = !std::isnan(values[f]);
+        if (!valid[f]) continue;
+        sum[f] += values[f];
+        sumSquares[f] += (double)values[f] * values[f];
+        if (validCount[f] == 0 || values[f] < min[f]) min[f] = values[f];
+        if (validCount[f] == 0 || values[f] > max[f]) max[f] = values[f];
+        validCount[f]++;
+    }
+    for (int p = 0; p < WindTempSolar::FIELD_COUNT; ++p) {
+        int a = PAIR_FIELDS[p][0];
+        int b = PAIR_FIELDS[p][1];
+        if (!valid[a] || !valid[b]) continue;
+        pairCount[p]++;
+        pairSum[p][0] += values[a];
+        pairSum[p][1] += values[b];
+        pairSumSquares[p][0] += (double)values[a] * values[a];
+        pairSumSquares[p][1] += (double)values[b] * values[b];
+        sumProducts[p] += (double)values[a] * values[b];
+    }
+    count++;
+}
+
+// Counts a gap and the samples missing in it
+void MonthlySummary::addGap(long long missingSamples) {
+    gapCount++;
+    this->missingSamples += missingSamples;
+}
+
+// Takes back a gap and the samples missing in it
+void MonthlySummary::removeGap(long long missingSamples) {
+    gapCount--;
+    this->missingSamples -= missingSamples;
+}
+
+// Clears the gap counters
+void MonthlySummary::clearGaps() {
+    gapCount = 0;
+    missingSamples = 0;
+}
+
+// Counts a duplicate timestamp
+void MonthlySummary::addDuplicate() {
+    duplicateCount++;
+}
+
+// Merges another summary into this one
+void MonthlySummary::merge(const MonthlySummary& other) {
+    gapCount += other.gapCount;
+    missingSamples += other.missingSamples;
+    duplicateCount += other.duplicateCount;
+    if (other.count == 0) return;
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+        sum[f] += other.sum[f];
+        sumSquares[f] += other.sumSquares[f];
+        if (other.validCount[f] > 0) {
+            if (validCount[f] == 0 || other.min[f] < min[f]) min[f] = other.min[f];
+            if (validCount[f] == 0 || other.max[f] > max[f]) max[f] = other.max[f];
+        }
+        validCount[f] += other.validCount[f];
+        pairCount[f] += other.pairCount[f];
+        for (int i = 0; i < 2; ++i) {
+            pairSum[f][i] += other.pairSum[f][i];
+            pairSumSquares[f][i] += other.pairSumSquares[f][i];
+        }
+        sumProducts[f] += other.sumProducts[f];
+    }
+    count += other.count;
+}
+
+// Returns the number of records in the summary
+long long MonthlySummary::getCount() const {
+    return count;
+}
+
+// Returns the mean of a field or 0 if no records were added
+float MonthlySummary::getMean(const std::string& field) const {
+    int f = WindTempSolar::getFieldIndex(field);
+    if (f < 0 || validCount[f] == 0) return 0;
+    return (float)(sum[f] / validCount[f]);
+}
+
+// Returns the standard deviation of a field from its sum and sum of squares
+float MonthlySummary::getStandardDeviation(const std::string& field) const {
+    int f = WindTempSolar::getFieldIndex(field);
+    if (f < 0 || validCount[f] == 0) return 0;
+    double mean = sum[f] / validCount[f];
+    double variance = sumSquares[f] / validCount[f] - mean * mean;
+    // Guard against small negative values caused by rounding
+    return (variance > 0) ? (float)std::sqrt(variance) : 0;
+}
+
+// Returns the sum of a field
+float MonthlySummary::getTotal(const std::string& field) const {
+    int f = WindTempSolar::getFieldIndex(field);
+    return (f < 0) ? 0 : (float)sum[f];
+}
+
+// Returns the minimum of a field
+float MonthlySummary::getMin(const std::string& field) const {
+    int f = WindTempSolar::getFieldIndex(field);
+    return (f < 0 || validCount[f] == 0) ? 0 : min[f];
+}
+
+// Returns the maximum of a field
+float MonthlySummary::getMax(const std::string& field) const {
+    int f = WindTempSolar::getFieldIndex(field);
+    return (f < 0 || validCount[f] == 0) ? 0 : max[f];
+}
+
+// Returns the sample Pearson correlation coefficient between two fields over the records where both are valid
+float MonthlySummary::getCorrelation(const std::string& field1, const std::string& field2) const {
+    int f1 = WindTempSolar::getFieldIndex(field1);
+    int f2 = WindTempSolar::getFieldIndex(field2);
+    if (f1 < 0 || f2 < 0) return 0;
+
+    long long n;
+    double sum1, sum2, sumSquares1, sumSquares2, sumProduct;
+    if (f1 == f2) {
+        n = validCount[f1];
+        sum1 = sum2 = sum[f1];
+        sumSquares1 = sumSquares2 = sumProduct = sumSquares[f1];
+    } else {
+        int p = getPairIndex(f1, f2);
+        n = pairCount[p];
+        sum1 = pairSum[p][0];
+        sum2 = pairSum[p][1];
+        sumSquares1 = pairSumSquares[p][0];
+        sumSquares2 = pairSumSquares[p][1];
+        sumProduct = sumProducts[p];
+    }
+    if (n == 0) return 0;
+
+    // Calculate the numerator and denominator of the correlation coefficient formula
+    double numerator = n * sumProduct - sum1 * sum2;
+    double denominator = std::sqrt((n * sumSquares1 - sum1 * sum1) * (n * sumSquares2 - sum2 * sum2));
+
+    // Avoid division by zero
+    return (denominator > 0) ? (float)(numerator / denominator) : 0;
+}
+
+// Returns the number of valid values of a field
+long long MonthlySummary::getValidCount(const std::string& field) const {
+    int f = WindTempSolar::getFieldIndex(field);
+    return (f < 0) ? 0 : validCount[f];
+}
+
+// Returns the number of missing values of a field
+long long MonthlySummary::getMissingCount(const std::string& field) const {
+    int f = WindTempSolar::getFieldIndex(field);
+    return (f < 0) ? 0 : count - validCount[f];
+}
+
+// Returns the number of records where both fields are valid
+long long MonthlySummary::getPairCount(const std::string& field1, const std::string& field2) const {
+    int f1 = WindTempSolar::getFieldIndex(field1);
+    int f2 = WindTempSolar::getFieldIndex(field2);
+    if (f1 < 0 || f2 < 0) return 0;
+    return (f1 == f2) ? validCount[f1] : pairCount[getPairIndex(f1, f2)];
+}
+
+// Returns the number of timestamp gaps
+long long MonthlySummary::getGapCount() const {
+    return gapCount;
+}
+
+// Returns the number of samples missing in the gaps
+long long MonthlySummary::getMissingSamples() const {
+    return missingSamples;
+}
+
+// Returns the number of duplicate timestamps
+long long MonthlySummary::getDuplicateCount() const {
+    return duplicateCount;
+}
+
+// Returns the percentage of expected samples with a valid value of a field
+float MonthlySummary::getCoverage(const std::string& field) const {
+    int f = WindTempSolar::getFieldIndex(field);
+    long long expected = count - duplicateCount + missingSamples;
+    if (f < 0 || expected <= 0) return 0;
+    // Valid duplicates could push the ratio past the expected samples
+    double coverage = 100.0 * validCount[f] / expected;
+    return (float)(coverage < 100 ? coverage : 100);
+}
+
+// Index of the cross-product for a pair of fields
+int MonthlySummary::getPairIndex(int field1, int field2) {
+    // Pairs are stored as (0,1), (0,2), (1,2); the field sum minus one gives that index
+    return field1 + field2 - 1;
+}
@@ -0,0 +1,203 @@
+#ifndef MONTHLYSUMMARY_H
+#define MONTHLYSUMMARY_H
+
+#include "WindTempSolar.h"
+#include <string>
+
+/**
+ * @brief Mergeable summary of all records that fall into one period (typically one month).
+ *
+ * A summary keeps the count, sum, sum of squares, minimum and maximum of every field,
+ * together with the cross-products needed for correlations. Means, standard deviations,
+ * totals and correlations can then be answered in constant time, and two summaries can be
+ * merged to obtain the summary of the combined period.
+ *
+ * Invalid values (NaN, see CsvParser) are left out of the statistics of their field: each field
+ * has its own count of valid values, and correlations use only the records where both fields
+ * are valid. The summary also keeps quality counters, the number of missing values per field,
+ * of timestamp gaps and the samples they miss, and of duplicate timestamps, so coverage can be
+ * reported per period.
+ */
+class MonthlySummary {
+public:
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs an empty summary.
+     */
+    MonthlySummary();
+
+    /**
+     * @brief Adds a record to the summary.
+     *
+     * @param record The record to add.
+     */
+    void add(const WindTempSolar& record);
+
+    /**
+     * @brief Records a gap in the timestamps before a record of the period.
+     *
+     * @param missingSamples The number of samples missing in the gap.
+     */
+    void addGap(long long missingSamples);
+
+    /**
+     * @brief Takes back a gap recorded with addGap, e.g. after a record filled part of it.
+     *
+     * @param missingSamples The number of samples that were missing in the gap.
+     */
+    void removeGap(long long missingSamples);
+
+    /**
+     * @brief Clears the gap counters, so the gaps can be counted again for a new sampling interval.
+     */
+    void clearGaps();
+
+    /**
+     * @brief Records a record whose timestamp repeats that of an earlier record.
+     */
+    void addDuplicate();
+
+    /**
+     * @brief Merges another summary into this one.
+     *
+     * @param other The summary to merge.
+     */
+    void merge(const MonthlySummary& other);
+
+    /**
+     * @brief Returns the number of records in the summary.
+     *
+     * @return The number of records.
+     */
+    long long getCount() const;
+
+    /**
+     * @brief Returns the mean of a field.
+     *
+     * @param field The name of the field (e.g., "wind_speed").
+     * @return The mean of the field, or 0 if the summary is empty or the field is unknown.
+     */
+    float getMean(const std::string& field) const;
+
+    /**
+     * @brief Returns the standard deviation of a field.
+     *
+     * The deviation is computed with a divisor of n, matching Math::calculateStandardDeviation.
+     *
+     * @param field The name of the field (e.g., "wind_speed").
+     * @return The standard deviation of the field, or 0 if the summary is empty or the field is unknown.
+     */
+    float getStandardDeviation(const std::string& field) const;
+
+    /**
+     * @brief Returns the total (sum) of a field.
+     *
+     * @param field The name of the field (e.g., "solar_radiation").
+     * @return The sum of the field, or 0 if the field is unknown.
+     */
+    float getTotal(const std::string& field) const;
+
+    /**
+     * @brief Returns the minimum value of a field.
+     *
+     * @param field The name of the field.
+     * @return The minimum value, or 0 if the summary is empty or the field is unknown.
+     */
+    float getMin(const std::string& field) const;
+
+    /**
+     * @brief Returns the maximum value of a field.
+     *
+     * @param field The name of the field.
+     * @return The maximum value, or 0 if the summary is empty or the field is unknown.
+     */
+    float getMax(const std::string& field) const;
+
+    /**
+     * @brief Returns the sample Pearson correlation coefficient between two fields.
+     *
+     * @param field1 The first field (e.g., "wind_speed").
+     * @param field2 The second field (e.g., "temperature").
+     * @return The correlation coefficient, or 0 if it is undefined or a field is unknown.
+     */
+    float getCorrelation(const std::string& field1, const std::string& field2) const;
+
+    /**
+     * @brief Returns the number of valid values of a field.
+     *
+     * @param field The name of the field.
+     * @return The number of valid values, or 0 if the field is unknown.
+     */
+    long long getValidCount(const std::string& field) const;
+
+    /**
+     * @brief Returns the number of records whose value of a field is missing or invalid.
+     *
+     * @param field The name of the field.
+     * @return The number of missing values, or 0 if the field is unknown.
+     */
+    long long getMissingCount(const std::string& field) const;
+
+    /**
+     * @brief Returns the number of records where both fields are valid.
+     *
+     * @param field1 The first field.
+     * @param field2 The second field.
+     * @return The number of records, or 0 if a field is unknown.
+     */
+    long long getPairCount(const std::string& field1, const std::string& field2) const;
+
+    /**
+     * @brief Returns the number of gaps in the timestamps.
+     *
+     * @return The number of gaps.
+     */
+    long long getGapCount() const;
+
+    /**
+     * @brief Returns the number of samples missing in the gaps.
+     *
+     * @return The number of missing samples.
+     */
+    long long getMissingSamples() const;
+
+    /**
+     * @brief Returns the number of records whose timestamp repeats the previous one.
+     *
+     * @return The number of duplicates.
+     */
+    long long getDuplicateCount() const;
+
+    /**
+     * @brief Returns the percentage of expected samples that have a valid value of a field.
+     *
+     * The expected samples are the records without duplicates plus the samples missing in gaps.
+     *
+     * @param field The name of the field.
+     * @return The coverage (0-100), or 0 if no samples are expected or the field is unknown.
+     */
+    float getCoverage(const std::string& field) const;
+
+private:
+    /**
+     * @brief Returns the index into sumProducts for a pair of distinct field indexes.
+     */
+    static int getPairIndex(int field1, int field2);
+
+    long long count;                                  /**< Number of records in the summary. */
+    long long validCount[WindTempSolar::FIELD_COUNT]; /**< Number of valid values of each field. */
+    double sum[WindTempSolar::FIELD_COUNT];           /**< Sum of the valid values of each field. */
+    double sumSquares[WindTempSolar::FIELD_COUNT];    /**< Sum of squares of the valid values of each field. */
+    float min[WindTempSolar::FIELD_COUNT];            /**< Minimum of each field. */
+    float max[WindTempSolar::FIELD_COUNT];            /**< Maximum of each field. */
+    long long pairCount[WindTempSolar::FIELD_COUNT];  /**< Records where both fields of a pair are valid: wind/temperature, wind/solar, temperature/solar. */
+    double pairSum[WindTempSolar::FIELD_COUNT][2];    /**< Sums of both fields of each pair over those records. */
+    double pairSumSquares[WindTempSolar::FIELD_COUNT][2]; /**< Sums of squares of both fields of each pair over those records. */
+    double sumProducts[WindTempSolar::FIELD_COUNT];   /**< Cross-products of each pair over those records. */
+    long long gapCount;                               /**< Number of timestamp gaps. */
+    long long missingSamples;                         /**< Samples missing in the gaps. */
+    long long duplicateCount;                         /**< Records repeating the previous timestamp. */
+};
+
+#endif // MONTHLYSUMMARY_H
@@ -0,0 +1,79 @@
+#ifndef PARALLELSORT_H
+#define PARALLELSORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Parallel merge sort over random-access ranges.
+ *
+ * The range is split into one slice per thread, the slices are sorted concurrently with
+ * std::sort, and neighbouring slices are then merged pairwise, each round of merges also
+ * running concurrently. Small ranges are sorted on the calling thread.
+ */
+class ParallelSort {
+public:
+    /**
+     * @brief Ranges shorter than this are sorted on the calling thread.
+     */
+    static const size_t MIN_PARALLEL_SIZE = 1 << 15;
+
+    /**
+     * @brief Sorts a range.
+     *
+     * The order of elements that compare equal is unspecified, as with std::sort.
+     *
+     * @tparam RandomIt A random-access iterator type.
+     * @tparam Less A strict weak ordering of the elements.
+     * @param first The beginning of the range.
+     * @param last The end of the range.
+     * @param less The ordering.
+     * @param threadCount The number of threads, or 0 to use one per hardware thread.
+     */
+    template <class RandomIt, class Less>
+    static void sort(RandomIt first, RandomIt last, Less less, size_t threadCount = 0);
+};
+
+// Implementation
+
+template <class RandomIt, class Less>
+void ParallelSort::sort(RandomIt first, RandomIt last, Less less, size_t threadCount) {
+    size_t size = (size_t)std::distance(first, last);
+    if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    if (threadCount > size / (MIN_PARALLEL_SIZE / 2)) threadCount = size / (MIN_PARALLEL_SIZE / 2);
+    if (threadCount <= 1 || size < MIN_PARALLEL_SIZE) {
+        std::sort(first, last, less);
+        return;
+    }
+
+    // Sort one slice per thread
+    std::vector<size_t> bounds;
+    for (size_t i = 0; i <= threadCount; ++i) {
+        bounds.push_back(size * i / threadCount);
+    }
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.push_back(std::thread([=]() { std::sort(first + bounds[i], first + bounds[i + 1], less); }));
+    }
+    for (size_t i = 0; i < workers.size(); ++i) workers[i].join();
+
+    // Merge neighbouring sorted runs until a single run remains
+    while (bounds.size() > 2) {
+        workers.clear();
+        std::vector<size_t> merged;
+        for (size_t i = 0; i + 2 < bounds.size(); i += 2) {
+            size_t begin = bounds[i], middle = bounds[i + 1], end = bounds[i + 2];
+            workers.push_back(std::thread([=]() { std::inplace_merge(first + begin, first + middle, first + end, less); }));
+            merged.push_back(begin);
+        }
+        if (bounds.size() % 2 == 0) merged.push_back(bounds[bounds.size() - 2]); // Odd run carried over
+        merged.push_back(bounds.back());
+        for (size_t i = 0; i < workers.size(); ++i) workers[i].join();
+        bounds.swap(merged);
+    }
+}
+
+#endif // PARALLELSORT_H
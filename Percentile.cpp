@@ -0,0 +1,39 @@
+#include "Percentile.h"
+#include <algorithm>
+#include <cmath>
+
+// Calculates a percentile by selecting the neighbouring ranks with nth_element
+float Percentile::calculatePercentile(std::vector<float>& values, float percentile) {
+    if (values.empty()) return 0;
+    if (percentile < 0) percentile = 0;
+    if (percentile > 100) percentile = 100;
+
+    // Position of the percentile between the smallest (0) and the largest (n - 1) value
+    double position = percentile / 100.0 * (values.size() - 1);
+    size_t lower = (size_t)position;
+    double fraction = position - lower;
+
+    std::nth_element(values.begin(), values.begin() + lower, values.end());
+    float lowerValue = values[lower];
+    if (fraction == 0 || lower + 1 >= values.size()) {
+        return lowerValue;
+    }
+    // After nth_element the next rank is the smallest value of the upper partition
+    float upperValue = *std::min_element(values.begin() + lower + 1, values.end());
+    return (float)(lowerValue + fraction * (upperValue - lowerValue));
+}
+
+// Calculates the median as the 50th percentile
+float Percentile::calculateMedian(std::vector<float>& values) {
+    return calculatePercentile(values, 50);
+}
+
+// Calculates the median of the absolute differences from the median
+float Percentile::calculateMedianAbsoluteDeviation(std::vector<float>& values) {
+    if (values.empty()) return 0;
+    float median = calculateMedian(values);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = std::abs(values[i] - median);
+    }
+    return calculateMedian(values);
+}
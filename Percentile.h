@@ -0,0 +1,44 @@
+#ifndef PERCENTILE_H
+#define PERCENTILE_H
+
+#include <vector>
+
+/**
+ * @brief The Percentile class provides static methods for exact order statistics.
+ *
+ * Values are selected with std::nth_element, so a percentile costs linear time in the
+ * number of values instead of a full sort. The input vectors are reordered in place.
+ */
+class Percentile {
+public:
+    /**
+     * @brief Calculate and return a percentile of the values.
+     *
+     * Uses linear interpolation between the two closest ranks.
+     *
+     * @param values The values; they are reordered by the call.
+     * @param percentile The percentile to compute (0-100).
+     * @return The percentile, or 0 if there are no values.
+     */
+    static float calculatePercentile(std::vector<float>& values, float percentile);
+
+    /**
+     * @brief Calculate and return the median of the values.
+     *
+     * @param values The values; they are reordered by the call.
+     * @return The median, or 0 if there are no values.
+     */
+    static float calculateMedian(std::vector<float>& values);
+
+    /**
+     * @brief Calculate and return the median absolute deviation of the values.
+     *
+     * This is the median of the absolute differences from the median.
+     *
+     * @param values The values; they are overwritten by the call.
+     * @return The median absolute deviation, or 0 if there are no values.
+     */
+    static float calculateMedianAbsoluteDeviation(std::vector<float>& values);
+};
+
+#endif // PERCENTILE_H
@@ -0,0 +1,164 @@
+#include "Profiler.h"
+#include "ReportWriter.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+// Totals of one scope name for the summary table
+struct ScopeTotals {
+    std::string name;
+    long long calls;
+    long long total;
+    long long longest;
+};
+
+// Orders totals by total time, slowest first
+bool slowerFirst(const ScopeTotals& a, const ScopeTotals& b) {
+    return a.total > b.total || (a.total == b.total && a.name < b.name);
+}
+
+// Converts a duration to microseconds
+long long toMicroseconds(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+}
+
+// Returns the profiler of the process, created on first use
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+// Constructor starts the clock of the events
+Profiler::Profiler() : origin(std::chrono::steady_clock::now()) {}
+
+// Records a finished scope on the calling thread
+void Profiler::addEvent(const std::string& name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Event event;
+    event.name = name;
+    event.start = toMicroseconds(start - origin);
+    event.duration = toMicroseconds(end - start);
+    event.thread = getThreadNumber();
+    events.push_back(event);
+}
+
+// Adds to a counter
+void Profiler::addCount(const std::string& name, long long amount) {
+    std::lock_guard<std::mutex> lock(mutex);
+    counters[name] += amount;
+}
+
+// Prints the scopes by total time and then the counters
+void Profiler::printSummary(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::map<std::string, ScopeTotals> byName;
+    for (size_t i = 0; i < events.size(); ++i) {
+        ScopeTotals& totals = byName[events[i].name];
+        if (totals.name.empty()) {
+            totals.name = events[i].name;
+            totals.calls = totals.total = totals.longest = 0;
+        }
+        totals.calls++;
+        totals.total += events[i].duration;
+        totals.longest = std::max(totals.longest, events[i].duration);
+    }
+    std::vector<ScopeTotals> rows;
+    for (std::map<std::string, ScopeTotals>::const_iterator it = byName.begin(); it != byName.end(); ++it) {
+        rows.push_back(it->second);
+    }
+    std::sort(rows.begin(), rows.end(), slowerFirst);
+
+    std::ios::fmtflags flags = out.flags();
+    out << std::left << std::setw(40) << "Scope" << std::right << std::setw(10) << "Calls"
+        << std::setw(14) << "Total (ms)" << std::setw(14) << "Mean (us)" << std::setw(14) << "Max (ms)" << '\n';
+    out << std::fixed;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        out << std::left << std::setw(40) << rows[i].name << std::right << std::setw(10) << rows[i].calls
+            << std::setw(14) << std::setprecision(3) << rows[i].total / 1000.0
+            << std::setw(14) << std::setprecision(1) << (double)rows[i].total / rows[i].calls
+            << std::setw(14) << std::setprecision(3) << rows[i].longest / 1000.0 << '\n';
+    }
+    if (!counters.empty()) {
+        out << '\n' << std::left << std::setw(40) << "Counter" << std::right << std::setw(16) << "Value" << '\n';
+        for (std::map<std::string, long long>::const_iterator it = counters.begin(); it != counters.end(); ++it) {
+            out << std::left << std::setw(40) << it->first << std::right << std::setw(16) << it->second << '\n';
+        }
+    }
+    out.flags(flags);
+    out.flush();
+}
+
+// Writes the events as complete ("X") events of a Chrome trace in JSON array format
+bool Profiler::writeTrace(const std::string& filename, std::string& error) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    ReportWriter writer(filename, ReportWriter::JSON);
+    if (!writer.isOpen()) {
+        error = "Unable to open " + filename;
+        return false;
+    }
+    std::vector<std::string> columns;
+    columns.push_back("name");
+    columns.push_back("ph");
+    columns.push_back("pid");
+    columns.push_back("tid");
+    columns.push_back("ts");
+    columns.push_back("dur");
+    writer.setColumns(columns);
+    for (size_t i = 0; i < events.size(); ++i) {
+        writer.beginRow();
+        writer.addText(events[i].name);
+        writer.addText("X");
+        writer.addInteger(1);
+        writer.addInteger(events[i].thread);
+        writer.addInteger(events[i].start);
+        writer.addInteger(events[i].duration);
+        writer.endRow();
+    }
+    if (!writer.finish()) {
+        error = "Unable to write " + filename;
+        return false;
+    }
+    return true;
+}
+
+// Discards all events and counters
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.clear();
+    counters.clear();
+}
+
+// Numbers threads in the order they first record an event; the caller holds the lock
+int Profiler::getThreadNumber() {
+    std::thread::id id = std::this_thread::get_id();
+    std::map<std::thread::id, int>::iterator it = threads.find(id);
+    if (it == threads.end()) {
+        it = threads.insert(std::make_pair(id, (int)threads.size() + 1)).first;
+    }
+    return it->second;
+}
+
+// Constructor starts the clock of the scope, creating the profiler first so its origin comes before the start
+ProfileScope::ProfileScope(const std::string& name) : name(name) {
+    Profiler::instance();
+    start = std::chrono::steady_clock::now();
+}
+
+// Destructor records the scope
+ProfileScope::~ProfileScope() {
+    Profiler::instance().addEvent(name, start, std::chrono::steady_clock::now());
+}
+
+// Constructor remembers where to report
+ProfileReport::ProfileReport(const std::string& traceFile, std::ostream& out) : traceFile(traceFile), out(out) {}
+
+// Destructor prints the summary and writes the trace
+ProfileReport::~ProfileReport() {
+    Profiler& profiler = Profiler::instance();
+    profiler.printSummary(out);
+    std::string error;
+    if (!traceFile.empty() && !profiler.writeTrace(traceFile, error)) {
+        out << "Error: " << error << std::endl;
+    }
+}
@@ -0,0 +1,167 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Collects timed scopes and counters of the ingest and query stages.
+ *
+ * Code is instrumented with the PROFILE_SCOPE and PROFILE_COUNT macros, which expand to
+ * nothing unless WEATHER_PROFILE is defined, so a normal build carries no instrumentation at
+ * all. In a profiling build every scope records one event when it ends. The events can be
+ * printed as a summary table per scope name, or written as a Chrome trace-format JSON file
+ * (load it in chrome://tracing or Perfetto) showing each scope on the thread that ran it.
+ *
+ * Scopes are meant for stages, files, chunks and calls, not for single records: recording an
+ * event takes a lock.
+ */
+class Profiler {
+public:
+    /**
+     * @brief Returns the profiler of the process.
+     *
+     * @return The profiler.
+     */
+    static Profiler& instance();
+
+    /**
+     * @brief Records a finished scope.
+     *
+     * @param name The name of the scope.
+     * @param start The time the scope started.
+     * @param end The time the scope ended.
+     */
+    void addEvent(const std::string& name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+    /**
+     * @brief Adds to a named counter.
+     *
+     * @param name The name of the counter.
+     * @param amount The amount to add.
+     */
+    void addCount(const std::string& name, long long amount);
+
+    /**
+     * @brief Prints the number of calls and the total, mean and maximum time of each scope,
+     * slowest first, followed by the counters.
+     *
+     * @param out The stream to print to.
+     */
+    void printSummary(std::ostream& out) const;
+
+    /**
+     * @brief Writes the events in Chrome trace format (a JSON array of complete events).
+     *
+     * Counters are only part of the summary table.
+     *
+     * @param filename The name of the file to write.
+     * @param error Receives the reason if the file cannot be written.
+     * @return true if the file was written, false otherwise.
+     */
+    bool writeTrace(const std::string& filename, std::string& error) const;
+
+    /**
+     * @brief Discards all events and counters.
+     */
+    void clear();
+
+private:
+    /**
+     * @brief A finished scope.
+     */
+    struct Event {
+        std::string name;       ///< Name of the scope
+        long long start;        ///< Start in microseconds since the profiler was created
+        long long duration;     ///< Duration in microseconds
+        int thread;             ///< Small number of the thread that ran the scope
+    };
+
+    /**
+     * @brief Constructs an empty profiler; times are measured from this point.
+     */
+    Profiler();
+
+    /**
+     * @brief Returns the small number of the calling thread, assigning one on first use.
+     */
+    int getThreadNumber();
+
+    std::chrono::steady_clock::time_point origin;   /**< Time zero of the events. */
+    std::vector<Event> events;                      /**< Finished scopes in the order they ended. */
+    std::map<std::string, long long> counters;      /**< Counters by name. */
+    std::map<std::thread::id, int> threads;         /**< Small numbers of the threads seen. */
+    mutable std::mutex mutex;                       /**< Guards the events, counters and threads. */
+};
+
+/**
+ * @brief Times the enclosing scope and records it with the Profiler when it ends.
+ */
+class ProfileScope {
+public:
+    /**
+     * @brief Starts timing a scope.
+     *
+     * @param name The name of the scope.
+     */
+    explicit ProfileScope(const std::string& name);
+
+    /**
+     * @brief Stops timing and records the scope.
+     */
+    ~ProfileScope();
+
+private:
+    ProfileScope(const ProfileScope&);
+    ProfileScope& operator=(const ProfileScope&);
+
+    std::string name;                               /**< Name of the scope. */
+    std::chrono::steady_clock::time_point start;    /**< Time the scope started. */
+};
+
+/**
+ * @brief Prints the profiler summary, and writes the trace if a file is given, when it goes out of scope.
+ */
+class ProfileReport {
+public:
+    /**
+     * @brief Constructs a report.
+     *
+     * @param traceFile The name of the trace file to write, or empty for no trace.
+     * @param out The stream to print the summary to.
+     */
+    ProfileReport(const std::string& traceFile, std::ostream& out);
+
+    /**
+     * @brief Prints the summary and writes the trace.
+     */
+    ~ProfileReport();
+
+private:
+    ProfileReport(const ProfileReport&);
+    ProfileReport& operator=(const ProfileReport&);
+
+    std::string traceFile;  /**< Trace file to write, or empty. */
+    std::ostream& out;      /**< Stream the summary is printed to. */
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef WEATHER_PROFILE
+/** Times the rest of the enclosing block under the given name. */
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+/** Adds an amount to the named counter. */
+#define PROFILE_COUNT(name, amount) Profiler::instance().addCount((name), (long long)(amount))
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_COUNT(name, amount) ((void)0)
+#endif
+
+#endif // PROFILER_H
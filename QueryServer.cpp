@@ -0,0 +1,187 @@
+#include "QueryServer.h"
+#include "BatchReport.h"
+#include <sstream>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace {
+#ifndef _WIN32
+// Writes a whole string to a socket
+bool sendAll(int socket, const std::string& text) {
+    int flags = 0;
+#ifdef MSG_NOSIGNAL
+    flags = MSG_NOSIGNAL; // A client that disconnects must not kill the server
+#endif
+    size_t sent = 0;
+    while (sent < text.size()) {
+        ssize_t written = send(socket, text.data() + sent, text.size() - sent, flags);
+        if (written <= 0) return false;
+        sent += (size_t)written;
+    }
+    return true;
+}
+#endif
+
+// How often a connection waiting for a request checks whether the server is stopping, in milliseconds
+const int STOP_POLL_INTERVAL = 200;
+}
+
+// Constructor creates a server that is not yet listening
+QueryServer::QueryServer(const WeatherDataset& dataset, size_t threadCount)
+    : dataset(dataset), pool(threadCount), listener(-1), stopping(false), connections(0) {}
+
+// Destructor closes the socket and removes its file
+QueryServer::~QueryServer() {
+    stop();
+#ifndef _WIN32
+    if (listener >= 0) {
+        close(listener);
+        unlink(socketPath.c_str());
+    }
+#endif
+}
+
+// Creates the listening Unix domain socket
+bool QueryServer::listen(const std::string& socketPath, std::string& error) {
+#ifdef _WIN32
+    (void)socketPath;
+    error = "the query server needs Unix domain sockets, which are not available on this platform";
+    return false;
+#else
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+        error = "invalid socket path " + socketPath;
+        return false;
+    }
+    std::strcpy(address.sun_path, socketPath.c_str());
+
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        error = std::string("unable to create socket: ") + std::strerror(errno);
+        return false;
+    }
+    unlink(socketPath.c_str());
+    if (bind(listener, (sockaddr*)&address, sizeof(address)) < 0 || ::listen(listener, 64) < 0) {
+        error = "unable to listen on " + socketPath + ": " + std::strerror(errno);
+        close(listener);
+        listener = -1;
+        return false;
+    }
+    this->socketPath = socketPath;
+    return true;
+#endif
+}
+
+// Accepts connections and hands each one to a worker, turning away connections no worker is free for
+void QueryServer::run() {
+#ifndef _WIN32
+    while (!stopping && listener >= 0) {
+        int client = accept(listener, 0, 0);
+        if (client < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (connections >= pool.getThreadCount()) {
+            sendAll(client, "ERROR server busy\n\n");
+            close(client);
+            continue;
+        }
+        ++connections;
+        pool.submit([this, client]() {
+            serve(client);
+            --connections;
+        });
+    }
+#endif
+}
+
+// Makes the accept loop return
+void QueryServer::stop() {
+    stopping = true;
+#ifndef _WIN32
+    if (listener >= 0) shutdown(listener, SHUT_RDWR);
+#endif
+}
+
+// Answers one request line
+std::string QueryServer::handleRequest(const std::string& request, int& stationId) const {
+    std::istringstream words(request);
+    std::string command;
+    words >> command;
+    if (command == "PING") {
+        return "OK\n\n";
+    }
+    if (command == "STATION") {
+        std::string name;
+        words >> name;
+        if (name == "all") {
+            stationId = StationStore::ALL_STATIONS;
+            return "OK\n\n";
+        }
+        int found = dataset.findStation(name);
+        if (found < 0) return "ERROR unknown station " + name + "\n\n";
+        stationId = found;
+        return "OK\n\n";
+    }
+
+    BatchReport report;
+    std::string error;
+    if (!report.addReport(request, error)) {
+        return "ERROR " + error + "\n\n";
+    }
+    std::ostringstream response;
+    ReportWriter writer(response);
+    dataset.writeReport(report, writer, stationId);
+    writer.writeText("\n");
+    writer.finish();
+    return response.str();
+}
+
+// Reads request lines from a connection and writes their responses
+void QueryServer::serve(int client) const {
+#ifdef _WIN32
+    (void)client;
+#else
+    int stationId = StationStore::ALL_STATIONS;
+    std::string pending;
+    char buffer[4096];
+    bool open = true;
+    while (open && !stopping) {
+        pollfd readable = { client, POLLIN, 0 };
+        int ready = poll(&readable, 1, STOP_POLL_INTERVAL);
+        if (ready < 0 && errno != EINTR) break;
+        if (ready <= 0) continue;
+        ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+        if (received <= 0) break;
+        pending.append(buffer, (size_t)received);
+
+        size_t newline;
+        while (open && (newline = pending.find('\n')) != std::string::npos) {
+            if (newline > MAX_REQUEST_LENGTH) break;
+            std::string request = pending.substr(0, newline);
+            pending.erase(0, newline + 1);
+            if (!request.empty() && request[request.size() - 1] == '\r') request.erase(request.size() - 1);
+            if (request.empty()) continue;
+            if (request == "QUIT") {
+                open = false;
+            } else {
+                open = sendAll(client, handleRequest(request, stationId));
+            }
+        }
+        if (open && pending.size() > MAX_REQUEST_LENGTH) {
+            sendAll(client, "ERROR request longer than " + std::to_string(MAX_REQUEST_LENGTH) + " bytes\n\n");
+            open = false;
+        }
+    }
+    close(client);
+#endif
+}
@@ -0,0 +1,94 @@
+#ifndef QUERYSERVER_H
+#define QUERYSERVER_H
+
+#include "WeatherDataset.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <string>
+
+/**
+ * @brief Long-running server answering queries over a local Unix domain socket.
+ *
+ * The dataset stays loaded and indexed between requests. The protocol is line based: a
+ * client sends one request per line and every response ends with an empty line.
+ * - "<metric> <field> [<field2>] <period>" answers a report in the BatchReport syntax as CSV.
+ * - "STATION <name>" selects the station for later reports of the connection ("all" for every station).
+ * - "PING" answers "OK".
+ * - "QUIT" closes the connection.
+ * Errors are answered with "ERROR <message>". A request longer than MAX_REQUEST_LENGTH is
+ * answered with an error and its connection is closed.
+ *
+ * Connections are served by a thread pool, each connection occupying one worker while it is
+ * open. Connections beyond the number of workers are answered "ERROR server busy" and closed
+ * rather than queued, so a client is never left waiting behind idle connections. Requests are
+ * answered through the locked methods of the dataset, so data can be loaded while serving.
+ */
+class QueryServer {
+public:
+    /**
+     * @brief The longest request line accepted, in bytes.
+     */
+    static const size_t MAX_REQUEST_LENGTH = 4096;
+
+    /**
+     * @brief Constructs a server over a dataset.
+     *
+     * @param dataset The dataset to answer queries from.
+     * @param threadCount The number of connection workers, or 0 to use one per hardware thread.
+     */
+    QueryServer(const WeatherDataset& dataset, size_t threadCount = 0);
+
+    /**
+     * @brief Stops the server and closes its socket.
+     */
+    ~QueryServer();
+
+    /**
+     * @brief Creates the listening socket, replacing any stale socket file.
+     *
+     * @param socketPath The file system path of the socket.
+     * @param error Receives a description of the problem on failure.
+     * @return true if the server is listening, false otherwise.
+     */
+    bool listen(const std::string& socketPath, std::string& error);
+
+    /**
+     * @brief Accepts and serves connections until stop() is called.
+     */
+    void run();
+
+    /**
+     * @brief Makes run() return and closes open connections once their current request is answered.
+     *
+     * Only sets a flag and shuts the listening socket down, so it may be called from a signal handler.
+     */
+    void stop();
+
+    /**
+     * @brief Answers a single request line.
+     *
+     * @param request The request line.
+     * @param stationId The station selected on the connection; updated by STATION requests.
+     * @return The response, ending with an empty line.
+     */
+    std::string handleRequest(const std::string& request, int& stationId) const;
+
+private:
+    QueryServer(const QueryServer&);
+    QueryServer& operator=(const QueryServer&);
+
+    /**
+     * @brief Serves the requests of one connection until it is closed.
+     * @param client The socket of the connection.
+     */
+    void serve(int client) const;
+
+    const WeatherDataset& dataset;      /**< The dataset queries are answered from. */
+    ThreadPool pool;                    /**< Workers serving connections. */
+    int listener;                       /**< The listening socket, or -1. */
+    std::string socketPath;             /**< Path of the socket file. */
+    std::atomic<bool> stopping;         /**< Set by stop(). */
+    std::atomic<size_t> connections;    /**< Connections being served. */
+};
+
+#endif // QUERYSERVER_H
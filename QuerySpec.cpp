@@ -0,0 +1,90 @@
+#include "QuerySpec.h"
+
+// Default constructor creates a wind speed mean query with an empty period
+QuerySpec::QuerySpec() : metric(MEAN), field("wind_speed"), month(0), year(0), endMonth(0), endYear(0), percentile(50), windowStart(0), windowEnd(0) {}
+
+// Constructor for a query over one month (year 0 means all years)
+QuerySpec::QuerySpec(Metric metric, const std::string& field, int month, int year, const std::string& field2)
+    : metric(metric), field(field), field2(field2), month(month), year(year), endMonth(0), endYear(0), percentile(50), windowStart(0), windowEnd(0) {}
+
+// Creates a query over an inclusive range of months
+QuerySpec QuerySpec::range(Metric metric, const std::string& field, int month, int year, int endMonth, int endYear, const std::string& field2) {
+    QuerySpec query(metric, field, month, year, field2);
+    query.endMonth = endMonth;
+    query.endYear = endYear;
+    return query;
+}
+
+// Creates a query over a time window
+QuerySpec QuerySpec::window(Metric metric, const std::string& field, long long start, long long end) {
+    QuerySpec query(metric, field, 0, 0);
+    query.windowStart = start;
+    query.windowEnd = end;
+    return query;
+}
+
+// Sets the percentile of a percentile query
+QuerySpec& QuerySpec::withPercentile(float percentile) {
+    this->percentile = percentile;
+    return *this;
+}
+
+// Checks whether the query needs a scan of the raw data
+bool QuerySpec::needsScan() const {
+    if (isWindow()) return false;
+    return metric == MEAN_ABSOLUTE_DEVIATION || metric == PERCENTILE || metric == MEDIAN_ABSOLUTE_DEVIATION;
+}
+
+// Checks whether a date falls inside the query period
+bool QuerySpec::matches(const Date& date) const {
+    if (isWindow()) {
+        long long dayStart = date.toDayNumber() * 24 * 60;
+        return dayStart < windowEnd && dayStart + 24 * 60 > windowStart;
+    }
+    if (isRange()) {
+        int key = date.getYear() * 12 + date.getMonth();
+        return key >= year * 12 + month && key <= endYear * 12 + endMonth;
+    }
+    if (year == 0) {
+        return date.getMonth() == month;
+    }
+    return date.getMonth() == month && date.getYear() == year;
+}
+
+// Returns the time window from the start of the first month to the start of the month after the last
+bool QuerySpec::getTimeRange(long long& start, long long& end) const {
+    if (isWindow()) {
+        start = windowStart;
+        end = windowEnd;
+        return true;
+    }
+    if (year == 0) return false;
+    int lastMonth = isRange() ? endMonth : month;
+    int lastYear = isRange() ? endYear : year;
+    start = Date(1, month, year).toDayNumber() * 24 * 60;
+    end = Date(1, lastMonth % 12 + 1, lastYear + lastMonth / 12).toDayNumber() * 24 * 60;
+    return true;
+}
+
+// Checks whether two queries cover the same period
+bool QuerySpec::samePeriod(const QuerySpec& other) const {
+    return month == other.month && year == other.year && endMonth == other.endMonth && endYear == other.endYear
+        && windowStart == other.windowStart && windowEnd == other.windowEnd;
+}
+
+// Builds a key identifying the query
+std::string QuerySpec::toKey() const {
+    return std::to_string(metric) + "|" + std::to_string(month) + "|" + std::to_string(year) + "|"
+           + std::to_string(endMonth) + "|" + std::to_string(endYear) + "|" + field + "," + field2 + "|" + std::to_string(percentile)
+           + (isWindow() ? "|" + std::to_string(windowStart) + "-" + std::to_string(windowEnd) : "");
+}
+
+// Checks whether the query covers a range of months
+bool QuerySpec::isRange() const {
+    return endYear != 0;
+}
+
+// Checks whether the query covers a time window
+bool QuerySpec::isWindow() const {
+    return windowEnd > windowStart;
+}
@@ -0,0 +1,157 @@
+#ifndef QUERYSPEC_H
+#define QUERYSPEC_H
+
+#include "Date.h"
+#include <string>
+
+/**
+ * @brief Description of a single statistic requested from CalcResults::evaluateBatch.
+ *
+ * A query names a metric, the field(s) it reads and the period it covers. The period is
+ * either one month of one year, one month across all years (year 0, as used by the SPCC
+ * query), an inclusive range of months from (month, year) to (endMonth, endYear), or a
+ * time window of whole hours or days. Window queries support MEAN, TOTAL and COUNT and are
+ * answered from the hourly or daily resampled series rather than the monthly cube.
+ */
+class QuerySpec {
+public:
+    /**
+     * @brief The statistics that can be requested.
+     */
+    enum Metric {
+        MEAN,                       /**< Mean of the field. */
+        STANDARD_DEVIATION,         /**< Standard deviation of the field. */
+        MEAN_ABSOLUTE_DEVIATION,    /**< Mean absolute deviation of the field (needs a data scan). */
+        TOTAL,                      /**< Sum of the field. */
+        MIN,                        /**< Minimum of the field. */
+        MAX,                        /**< Maximum of the field. */
+        CORRELATION,                /**< Sample Pearson correlation coefficient between field and field2. */
+        COUNT,                      /**< Number of records in the period. */
+        PERCENTILE,                 /**< Exact percentile of the field (needs a data scan). */
+        APPROXIMATE_PERCENTILE,     /**< Percentile of the field estimated from the cube's digests. */
+        MEDIAN_ABSOLUTE_DEVIATION,  /**< Median absolute deviation of the field (needs a data scan). */
+        COVERAGE,                   /**< Percentage of expected samples with a valid value of the field. */
+        MISSING,                    /**< Number of records whose value of the field is missing or invalid. */
+        GAPS,                       /**< Number of samples missing in timestamp gaps. */
+        DUPLICATES                  /**< Number of records repeating the previous timestamp. */
+    };
+
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs a MEAN query on wind speed with an empty period.
+     */
+    QuerySpec();
+
+    /**
+     * @brief Constructs a query over one month.
+     *
+     * @param metric The statistic to compute.
+     * @param field The field to read (e.g., "wind_speed").
+     * @param month The month (1-12).
+     * @param year The year, or 0 for the month across all years.
+     * @param field2 The second field, used by CORRELATION only.
+     */
+    QuerySpec(Metric metric, const std::string& field, int month, int year, const std::string& field2 = "");
+
+    /**
+     * @brief Constructs a query over an inclusive range of months.
+     *
+     * @param metric The statistic to compute.
+     * @param field The field to read.
+     * @param month The first month of the range.
+     * @param year The year of the first month.
+     * @param endMonth The last month of the range.
+     * @param endYear The year of the last month.
+     * @param field2 The second field, used by CORRELATION only.
+     * @return The query.
+     */
+    static QuerySpec range(Metric metric, const std::string& field, int month, int year, int endMonth, int endYear, const std::string& field2 = "");
+
+    /**
+     * @brief Constructs a query over a time window.
+     *
+     * @param metric The statistic to compute: MEAN, TOTAL or COUNT.
+     * @param field The field to read.
+     * @param start The start of the window in minutes since 1 January 1970.
+     * @param end The end of the window (exclusive).
+     * @return The query.
+     */
+    static QuerySpec window(Metric metric, const std::string& field, long long start, long long end);
+
+    /**
+     * @brief Sets the percentile computed by PERCENTILE and APPROXIMATE_PERCENTILE queries.
+     *
+     * @param percentile The percentile (0-100).
+     * @return This query, for chaining.
+     */
+    QuerySpec& withPercentile(float percentile);
+
+    /**
+     * @brief Checks whether the query must be answered from the raw data.
+     *
+     * @return true for deviation and exact percentile queries, false for queries answered from the cube or the resampled series.
+     */
+    bool needsScan() const;
+
+    /**
+     * @brief Checks whether a date falls inside the query period.
+     *
+     * For window queries this is true for every day that overlaps the window.
+     *
+     * @param date The date to check.
+     * @return true if the date is inside the period, false otherwise.
+     */
+    bool matches(const Date& date) const;
+
+    /**
+     * @brief Returns the time window covered by the query.
+     *
+     * @param start Receives the start of the window in minutes since 1 January 1970.
+     * @param end Receives the end of the window (exclusive).
+     * @return true if the period is a single time window, false for a month across all years.
+     */
+    bool getTimeRange(long long& start, long long& end) const;
+
+    /**
+     * @brief Checks whether two queries cover the same period.
+     *
+     * @param other The query to compare with.
+     * @return true if both queries cover the same period, false otherwise.
+     */
+    bool samePeriod(const QuerySpec& other) const;
+
+    /**
+     * @brief Returns a string that identifies the query, used as a cache key.
+     *
+     * @return The key of the query.
+     */
+    std::string toKey() const;
+
+    /**
+     * @brief Checks whether the query covers a range of months.
+     *
+     * @return true for range queries, false for single-month queries.
+     */
+    bool isRange() const;
+
+    /**
+     * @brief Checks whether the query covers a time window.
+     *
+     * @return true for window queries, false for monthly queries.
+     */
+    bool isWindow() const;
+
+    Metric metric;          /**< The statistic to compute. */
+    std::string field;      /**< The field to read. */
+    std::string field2;     /**< The second field for CORRELATION. */
+    int month;              /**< The (first) month of the period. */
+    int year;               /**< The (first) year of the period, 0 for all years. */
+    int endMonth;           /**< The last month of a range, 0 for single-month queries. */
+    int endYear;            /**< The last year of a range, 0 for single-month queries. */
+    float percentile;       /**< The percentile (0-100) for percentile queries. */
+    long long windowStart;  /**< The start of a window in minutes, 0 for monthly queries. */
+    long long windowEnd;    /**< The end of a window (exclusive), 0 for monthly queries. */
+};
+
+#endif // QUERYSPEC_H
@@ -0,0 +1,59 @@
+#include "RadixSort.h"
+#include <algorithm>
+#include <cstddef>
+
+namespace {
+const int DIGIT_BITS = 16;
+const size_t DIGIT_COUNT = (size_t)1 << DIGIT_BITS;
+const int PASS_COUNT = RecordKey::WORD_COUNT * 32 / DIGIT_BITS;
+const size_t MIN_RADIX_SIZE = DIGIT_COUNT; // Below this, clearing the count table costs more than comparing
+
+// Returns the digit of a key for a pass, pass 0 being the least significant
+inline uint32_t digitOf(const RecordKey& key, int pass) {
+    int word = RecordKey::WORD_COUNT - 1 - pass / 2;
+    return (pass % 2 == 0) ? (key.words[word] & 0xFFFFu) : (key.words[word] >> 16);
+}
+}
+
+// Sorts entries with one stable counting pass per 16-bit digit
+void RadixSort::sort(std::vector<RadixEntry>& entries) {
+    size_t size = entries.size();
+    if (size < 2) return;
+    if (size < MIN_RADIX_SIZE) {
+        std::stable_sort(entries.begin(), entries.end(), [](const RadixEntry& a, const RadixEntry& b) { return a.key < b.key; });
+        return;
+    }
+
+    // Count the digits of every pass in a single read of the input
+    std::vector<size_t> counts(PASS_COUNT * DIGIT_COUNT, 0);
+    for (size_t i = 0; i < size; ++i) {
+        for (int pass = 0; pass < PASS_COUNT; ++pass) {
+            counts[pass * DIGIT_COUNT + digitOf(entries[i].key, pass)]++;
+        }
+    }
+
+    std::vector<RadixEntry> buffer(size);
+    std::vector<RadixEntry>* source = &entries;
+    std::vector<RadixEntry>* target = &buffer;
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        size_t* count = &counts[pass * DIGIT_COUNT];
+        if (count[digitOf((*source)[0].key, pass)] == size) continue; // All digits equal
+
+        // Turn the counts into starting offsets, then scatter
+        size_t offset = 0;
+        for (size_t d = 0; d < DIGIT_COUNT; ++d) {
+            size_t c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        const RadixEntry* from = source->data();
+        RadixEntry* to = target->data();
+        for (size_t i = 0; i < size; ++i) {
+            to[count[digitOf(from[i].key, pass)]++] = from[i];
+        }
+        std::vector<RadixEntry>* swap = source;
+        source = target;
+        target = swap;
+    }
+    if (source != &entries) entries.swap(buffer);
+}
@@ -0,0 +1,35 @@
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include "RecordKey.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief A record key paired with the id of its record.
+ */
+struct RadixEntry {
+    RecordKey key;  ///< Key of the record
+    uint32_t id;    ///< Id of the record
+};
+
+/**
+ * @brief LSD radix sort of record keys.
+ *
+ * Keys are sorted by 16-bit digits from least to most significant, six counting passes over
+ * the 96-bit keys with no comparisons at all. Each pass is stable, so entries with equal keys
+ * keep their input order. Passes in which every entry has the same digit are skipped, which
+ * is common for narrow value ranges such as wind speeds. The count table holds 6 x 65536
+ * entries, so fewer entries than one table row are sorted with std::stable_sort instead.
+ */
+class RadixSort {
+public:
+    /**
+     * @brief Sorts entries by key.
+     *
+     * @param entries The entries; entries with equal keys keep their relative order.
+     */
+    static void sort(std::vector<RadixEntry>& entries);
+};
+
+#endif // RADIXSORT_H
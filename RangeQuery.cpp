@@ -0,0 +1,45 @@
+#include "RangeQuery.h"
+
+namespace {
+const char* SEASON_NAMES[4] = { "DJF", "MAM", "JJA", "SON" };
+
+// Returns the season (0 = DJF, 1 = MAM, 2 = JJA, 3 = SON) of a month
+int seasonOf(int month) {
+    return (month % 12) / 3;
+}
+
+// Returns the year a month's season is counted in; December belongs to the following DJF
+int seasonYearOf(int month, int year) {
+    return (month == 12) ? year + 1 : year;
+}
+}
+
+// Constructor creates a range query
+RangeQuery::RangeQuery(long long start, long long end, GroupBy groupBy) : start(start), end(end), groupBy(groupBy) {}
+
+// Creates a range query covering whole years
+RangeQuery RangeQuery::years(int firstYear, int lastYear, GroupBy groupBy) {
+    return RangeQuery(Date(1, 1, firstYear).toDayNumber() * 24 * 60, Date(1, 1, lastYear + 1).toDayNumber() * 24 * 60, groupBy);
+}
+
+// Returns the key of the group a date belongs to
+long long RangeQuery::getGroupKey(const Date& date) const {
+    switch (groupBy) {
+        case MONTH: return date.getYear() * 100LL + date.getMonth();
+        case YEAR: return date.getYear();
+        case SEASON: return seasonYearOf(date.getMonth(), date.getYear()) * 10LL + seasonOf(date.getMonth());
+        case MONTH_OF_YEAR: return date.getMonth();
+        default: return 0;
+    }
+}
+
+// Returns a readable label for the group a date belongs to
+std::string RangeQuery::getGroupLabel(const Date& date) const {
+    switch (groupBy) {
+        case MONTH: return std::to_string(date.getMonth()) + "/" + std::to_string(date.getYear());
+        case YEAR: return std::to_string(date.getYear());
+        case SEASON: return std::string(SEASON_NAMES[seasonOf(date.getMonth())]) + " " + std::to_string(seasonYearOf(date.getMonth(), date.getYear()));
+        case MONTH_OF_YEAR: return std::to_string(date.getMonth());
+        default: return "all";
+    }
+}
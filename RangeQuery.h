@@ -0,0 +1,76 @@
+#ifndef RANGEQUERY_H
+#define RANGEQUERY_H
+
+#include "Date.h"
+#include "MonthlySummary.h"
+#include <string>
+
+/**
+ * @brief A time range together with how its records should be grouped.
+ *
+ * Used by CalcResults::evaluateRange to produce one summary per group (e.g. per month or
+ * per season) over an arbitrary range of history in a single pass.
+ */
+class RangeQuery {
+public:
+    /**
+     * @brief How records in the range are grouped.
+     */
+    enum GroupBy {
+        NONE,           /**< One group for the whole range. */
+        MONTH,          /**< One group per calendar month (e.g. 3/2015). */
+        YEAR,           /**< One group per year. */
+        SEASON,         /**< One group per meteorological season; December counts towards the next year's DJF. */
+        MONTH_OF_YEAR   /**< One group per month of the year across all years (climatology). */
+    };
+
+    /**
+     * @brief Constructs a range query.
+     *
+     * @param start The start of the range in minutes since 1 January 1970 (see WindTempSolar::getTimestamp).
+     * @param end The end of the range (exclusive).
+     * @param groupBy How to group the records.
+     */
+    RangeQuery(long long start, long long end, GroupBy groupBy);
+
+    /**
+     * @brief Constructs a range query covering whole years.
+     *
+     * @param firstYear The first year of the range.
+     * @param lastYear The last year of the range (inclusive).
+     * @param groupBy How to group the records.
+     * @return The range query.
+     */
+    static RangeQuery years(int firstYear, int lastYear, GroupBy groupBy);
+
+    /**
+     * @brief Returns the key of the group a date belongs to. Keys sort in chronological order.
+     *
+     * @param date The date.
+     * @return The group key.
+     */
+    long long getGroupKey(const Date& date) const;
+
+    /**
+     * @brief Returns a readable label for the group a date belongs to (e.g. "3/2015" or "DJF 2016").
+     *
+     * @param date The date.
+     * @return The group label.
+     */
+    std::string getGroupLabel(const Date& date) const;
+
+    long long start;    /**< Start of the range in minutes. */
+    long long end;      /**< End of the range in minutes (exclusive). */
+    GroupBy groupBy;    /**< How records are grouped. */
+};
+
+/**
+ * @brief Summary of one group of a range query.
+ */
+struct GroupResult {
+    long long key;          ///< Key of the group, see RangeQuery::getGroupKey
+    std::string label;      ///< Readable label of the group
+    MonthlySummary summary; ///< Summary of the records in the group
+};
+
+#endif // RANGEQUERY_H
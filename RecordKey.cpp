@@ -0,0 +1,42 @@
+#include "RecordKey.h"
+#include <cmath>
+#include <cstring>
+
+// Builds the key of a record from its compared fields
+RecordKey RecordKey::fromRecord(const WindTempSolar& record) {
+    RecordKey key;
+    key.words[0] = encodeFloat(record.getWindSpeed());
+    key.words[1] = encodeFloat(record.getTemperature());
+    key.words[2] = encodeFloat(record.getSolarRadiation());
+    return key;
+}
+
+// Flips the bits of a float so that unsigned integer order matches float order
+uint32_t RecordKey::encodeFloat(float value) {
+    if (value == 0) value = 0;                  // Minus zero equals zero
+    if (std::isnan(value)) return 0xFFFFFFFFu;  // NaN after infinity
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+// Reverses encodeFloat
+float RecordKey::decodeFloat(uint32_t bits) {
+    if (bits == 0xFFFFFFFFu) return std::nanf("");
+    bits = (bits & 0x80000000u) ? (bits & 0x7FFFFFFFu) : ~bits;
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Compares the words from most to least significant
+bool RecordKey::operator<(const RecordKey& other) const {
+    if (words[0] != other.words[0]) return words[0] < other.words[0];
+    if (words[1] != other.words[1]) return words[1] < other.words[1];
+    return words[2] < other.words[2];
+}
+
+// Checks whether all words are equal
+bool RecordKey::operator==(const RecordKey& other) const {
+    return words[0] == other.words[0] && words[1] == other.words[1] && words[2] == other.words[2];
+}
@@ -0,0 +1,69 @@
+#ifndef RECORDKEY_H
+#define RECORDKEY_H
+
+#include "WindTempSolar.h"
+#include <cstdint>
+
+/**
+ * @brief Order-preserving 96-bit integer key of a record.
+ *
+ * The key holds wind speed, temperature and solar radiation, the fields compared by
+ * WindTempSolar::operator<, each mapped to an unsigned 32-bit integer whose order matches
+ * the float order: the sign bit of positive floats is set and negative floats have all
+ * their bits flipped. Minus zero is mapped to zero, so records that compare equal have
+ * equal keys and keys compare exactly like records. NaN, for which operator< defines no
+ * order, is mapped to a single value above infinity.
+ *
+ * Comparing keys takes integer comparisons only, and keys can be sorted by LSD radix
+ * passes (see RadixSort).
+ */
+struct RecordKey {
+    /**
+     * @brief Number of 32-bit words in a key.
+     */
+    static const int WORD_COUNT = 3;
+
+    uint32_t words[WORD_COUNT]; ///< Encoded wind speed, temperature and solar radiation, most significant first
+
+    /**
+     * @brief Returns the key of a record.
+     *
+     * @param record The record.
+     * @return The key.
+     */
+    static RecordKey fromRecord(const WindTempSolar& record);
+
+    /**
+     * @brief Maps a float to an unsigned integer with the same order.
+     *
+     * @param value The float.
+     * @return The encoded value.
+     */
+    static uint32_t encodeFloat(float value);
+
+    /**
+     * @brief Maps an encoded value back to its float.
+     *
+     * @param bits The encoded value.
+     * @return The float (zero for an encoded minus zero, a quiet NaN for an encoded NaN).
+     */
+    static float decodeFloat(uint32_t bits);
+
+    /**
+     * @brief Compares two keys.
+     *
+     * @param other The key to compare with.
+     * @return true if this key orders before the other key.
+     */
+    bool operator<(const RecordKey& other) const;
+
+    /**
+     * @brief Checks whether two keys are equal.
+     *
+     * @param other The key to compare with.
+     * @return true if the keys are equal.
+     */
+    bool operator==(const RecordKey& other) const;
+};
+
+#endif // RECORDKEY_H
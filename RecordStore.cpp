@@ -0,0 +1,215 @@
+#include "RecordStore.h"
+#include "ParallelSort.h"
+#include "RadixSort.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Orders ids by the keys of their records, breaking ties by id so the order is stable
+struct KeyLess {
+    const Vector<WindTempSolar>& records;
+    explicit KeyLess(const Vector<WindTempSolar>& records) : records(records) {}
+    bool operator()(RecordStore::RecordId a, RecordStore::RecordId b) const {
+        RecordKey ka = RecordKey::fromRecord(records[(int)a]);
+        RecordKey kb = RecordKey::fromRecord(records[(int)b]);
+        if (ka < kb) return true;
+        if (kb < ka) return false;
+        return a < b;
+    }
+};
+
+// Orders ids by the timestamps of their records, breaking ties by id
+struct TimestampLess {
+    typedef long long Key;
+    const Vector<WindTempSolar>& records;
+    explicit TimestampLess(const Vector<WindTempSolar>& records) : records(records) {}
+    Key key(RecordStore::RecordId id) const {
+        return records[(int)id].getTimestamp();
+    }
+    static bool keyLess(const Key& a, const Key& b) {
+        return a < b;
+    }
+    bool operator()(RecordStore::RecordId a, RecordStore::RecordId b) const {
+        long long ta = records[a].getTimestamp();
+        long long tb = records[b].getTimestamp();
+        return ta < tb || (ta == tb && a < b);
+    }
+};
+
+// Orders (key, id) entries by key, then by id
+template <class Less>
+struct EntryLess {
+    bool operator()(const std::pair<typename Less::Key, RecordStore::RecordId>& a,
+                    const std::pair<typename Less::Key, RecordStore::RecordId>& b) const {
+        if (Less::keyLess(a.first, b.first)) return true;
+        if (Less::keyLess(b.first, a.first)) return false;
+        return a.second < b.second;
+    }
+};
+}
+
+// Constructor creates an empty store
+RecordStore::RecordStore() : treeCount(0) {}
+
+// Appends a record and returns its id
+RecordStore::RecordId RecordStore::add(const WindTempSolar& record) {
+    records.push_back(record);
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+        validity[f].append(!std::isnan(record.getValue(f)));
+    }
+    return (RecordId)(records.size() - 1);
+}
+
+// Returns the number of records
+int RecordStore::size() const {
+    return records.size();
+}
+
+// Returns a record by id
+const WindTempSolar& RecordStore::operator[](RecordId id) const {
+    return records[(int)id];
+}
+
+// Returns all records in load order
+const Vector<WindTempSolar>& RecordStore::getRecords() const {
+    return records;
+}
+
+// Returns the validity bitmap of a field
+const ValidityMask& RecordStore::getValidity(int fieldIndex) const {
+    return validity[fieldIndex];
+}
+
+// Returns the ordered view, building or extending it first if needed
+const std::vector<RecordStore::RecordId>& RecordStore::getOrderedIndex() const {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    extendOrderedIndex();
+    return orderedIndex;
+}
+
+// Returns the tree of the records, bulk-loading it from the ordered view if needed
+const Bst<WindTempSolar>& RecordStore::getTree() const {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    if (treeCount != records.size()) {
+        PROFILE_SCOPE("RecordStore tree bulk load");
+        extendOrderedIndex();
+        std::vector<WindTempSolar> distinct;
+        distinct.reserve(orderedIndex.size());
+        RecordKey last = RecordKey();
+        for (size_t i = 0; i < orderedIndex.size(); ++i) {
+            const WindTempSolar& record = records[(int)orderedIndex[i]];
+            RecordKey key = RecordKey::fromRecord(record);
+            // Equal records are adjacent; the first loaded one is kept, as Bst::insert would
+            if (distinct.empty() || !(key == last)) distinct.push_back(record);
+            last = key;
+        }
+        tree.bulkLoad(distinct.data(), (int)distinct.size());
+        treeCount = records.size();
+    }
+    return tree;
+}
+
+// Visits the distinct records in order without building the tree
+void RecordStore::orderedTraversal(void (*visit)(WindTempSolar)) const {
+    const std::vector<RecordId>& index = getOrderedIndex();
+    RecordKey last = RecordKey();
+    for (size_t i = 0; i < index.size(); ++i) {
+        const WindTempSolar& record = records[(int)index[i]];
+        RecordKey key = RecordKey::fromRecord(record);
+        if (i == 0 || !(key == last)) visit(record);
+        last = key;
+    }
+}
+
+// Finds the positions of the records equal to a record by binary search on the keys
+std::pair<size_t, size_t> RecordStore::findEqualRange(const WindTempSolar& record) const {
+    const std::vector<RecordId>& index = getOrderedIndex();
+    RecordKey key = RecordKey::fromRecord(record);
+    std::vector<RecordId>::const_iterator first = std::partition_point(index.begin(), index.end(),
+        [this, &key](RecordId id) { return RecordKey::fromRecord(records[(int)id]) < key; });
+    std::vector<RecordId>::const_iterator last = std::partition_point(first, index.end(),
+        [this, &key](RecordId id) { return !(key < RecordKey::fromRecord(records[(int)id])); });
+    return std::make_pair((size_t)(first - index.begin()), (size_t)(last - index.begin()));
+}
+
+// Returns the timestamp view, building or extending it first if needed
+const std::vector<RecordStore::RecordId>& RecordStore::getTimestampIndex() const {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    extendIndex(timestampIndex, TimestampLess(records));
+    return timestampIndex;
+}
+
+// Finds the positions of a time window in the timestamp view
+std::pair<size_t, size_t> RecordStore::findTimeRange(long long start, long long end) const {
+    const std::vector<RecordId>& index = getTimestampIndex();
+    std::vector<RecordId>::const_iterator first = std::partition_point(index.begin(), index.end(),
+        [this, start](RecordId id) { return records[(int)id].getTimestamp() < start; });
+    std::vector<RecordId>::const_iterator last = std::partition_point(first, index.end(),
+        [this, end](RecordId id) { return records[(int)id].getTimestamp() < end; });
+    return std::make_pair((size_t)(first - index.begin()), (size_t)(last - index.begin()));
+}
+
+// Returns the memory used by the records and the built indexes
+size_t RecordStore::getMemoryBytes() const {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    size_t bytes = records.size() * sizeof(WindTempSolar)
+        + (orderedIndex.capacity() + timestampIndex.capacity()) * sizeof(RecordId);
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) bytes += validity[f].getMemoryBytes();
+    return bytes;
+}
+
+// Sorts the ids added since the index was built and merges them into it
+template <class Less>
+void RecordStore::extendIndex(std::vector<RecordId>& index, Less less) const {
+    size_t built = index.size();
+    size_t total = (size_t)records.size();
+    if (built == total) return;
+    PROFILE_SCOPE("RecordStore timestamp index");
+
+    // Sort packed (key, id) entries rather than ids, so comparisons read contiguous memory
+    // instead of following each id into the records
+    std::vector<std::pair<typename Less::Key, RecordId> > entries;
+    entries.reserve(total - built);
+    for (size_t id = built; id < total; ++id) {
+        entries.push_back(std::make_pair(less.key((RecordId)id), (RecordId)id));
+    }
+    // Data loaded in order is often already sorted, which is checked in linear time
+    if (!std::is_sorted(entries.begin(), entries.end(), EntryLess<Less>())) {
+        ParallelSort::sort(entries.begin(), entries.end(), EntryLess<Less>());
+    }
+    index.reserve(total);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        index.push_back(entries[i].second);
+    }
+    if (built > 0 && less(index[built], index[built - 1])) {
+        std::inplace_merge(index.begin(), index.begin() + built, index.end(), less);
+    }
+}
+
+// Radix-sorts the keys of the ids added since the ordered view was built and merges them into it
+void RecordStore::extendOrderedIndex() const {
+    size_t built = orderedIndex.size();
+    size_t total = (size_t)records.size();
+    if (built == total) return;
+    PROFILE_SCOPE("RecordStore ordered index");
+
+    std::vector<RadixEntry> entries;
+    entries.reserve(total - built);
+    bool sorted = true;
+    for (size_t id = built; id < total; ++id) {
+        RadixEntry entry = { RecordKey::fromRecord(records[(int)id]), (RecordId)id };
+        if (!entries.empty() && entry.key < entries.back().key) sorted = false;
+        entries.push_back(entry);
+    }
+    // Entries are in id order, so the stable radix sort breaks ties by id
+    if (!sorted) RadixSort::sort(entries);
+    orderedIndex.reserve(total);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        orderedIndex.push_back(entries[i].id);
+    }
+    KeyLess less(records);
+    if (built > 0 && less(orderedIndex[built], orderedIndex[built - 1])) {
+        std::inplace_merge(orderedIndex.begin(), orderedIndex.begin() + built, orderedIndex.end(), less);
+    }
+}
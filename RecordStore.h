@@ -0,0 +1,168 @@
+#ifndef RECORDSTORE_H
+#define RECORDSTORE_H
+
+#include "Vector.h"
+#include "Bst.h"
+#include "RecordKey.h"
+#include "ValidityMask.h"
+#include "WindTempSolar.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Primary store holding each record exactly once, with lazily built secondary indexes.
+ *
+ * Records are kept in load order and identified by their 32-bit position (record id), with a
+ * validity bitmap per field for kernels that skip invalid values. The ordered view
+ * (WindTempSolar::operator<, the order of a Bst traversal) and the timestamp view are arrays
+ * of record ids, built on first use and extended when records have been added since, so
+ * ingest only appends to the records and the bitmaps. The ordered view is built by
+ * radix-sorting the records' RecordKey values, and searched and deduplicated by comparing
+ * keys. A Bst over the ordered view is likewise only built when first requested, by
+ * bulk-loading the sorted records into a balanced tree. Index building is guarded by a mutex,
+ * so the views can be requested from concurrent queries as long as no records are being added.
+ */
+class RecordStore {
+public:
+    /**
+     * @brief Type of record ids.
+     */
+    typedef uint32_t RecordId;
+
+    /**
+     * @brief Constructs an empty store.
+     */
+    RecordStore();
+
+    /**
+     * @brief Appends a record.
+     *
+     * @param record The record to append.
+     * @return The id of the record.
+     */
+    RecordId add(const WindTempSolar& record);
+
+    /**
+     * @brief Returns the number of records.
+     *
+     * @return The number of records.
+     */
+    int size() const;
+
+    /**
+     * @brief Returns a record by id.
+     *
+     * @param id The id of the record.
+     * @return The record.
+     */
+    const WindTempSolar& operator[](RecordId id) const;
+
+    /**
+     * @brief Returns all records in load order.
+     *
+     * @return The records.
+     */
+    const Vector<WindTempSolar>& getRecords() const;
+
+    /**
+     * @brief Returns the validity bitmap of a field, maintained as records are added.
+     *
+     * @param fieldIndex The index of the field (see WindTempSolar::getValue).
+     * @return The bitmap; bit i is set when record i has a valid (non-NaN) value of the field.
+     */
+    const ValidityMask& getValidity(int fieldIndex) const;
+
+    /**
+     * @brief Returns the ids of all records ordered by WindTempSolar::operator<.
+     *
+     * Records that compare equal keep their load order. Records with a NaN field, which
+     * operator< does not order, are placed as RecordKey orders them.
+     *
+     * @return The ordered record ids.
+     */
+    const std::vector<RecordId>& getOrderedIndex() const;
+
+    /**
+     * @brief Finds the records equal to a record using the ordered view.
+     *
+     * @param record The record to look for.
+     * @return The first and one-past-last positions of the equal records in getOrderedIndex().
+     */
+    std::pair<size_t, size_t> findEqualRange(const WindTempSolar& record) const;
+
+    /**
+     * @brief Returns the records as a binary search tree.
+     *
+     * The tree is built the first time it is requested, and rebuilt if records have been
+     * added since: the ordered view is sorted in parallel and the distinct records are
+     * bulk-loaded into a balanced tree. As with Bst::insert, records that compare equal are
+     * stored once.
+     *
+     * @return The tree.
+     */
+    const Bst<WindTempSolar>& getTree() const;
+
+    /**
+     * @brief Visits the distinct records in the order of a Bst traversal, without building the tree.
+     *
+     * The visited records are those Bst::inOrderTraversal would visit on getTree().
+     *
+     * @param visit Pointer to a function to call on each record.
+     */
+    void orderedTraversal(void (*visit)(WindTempSolar)) const;
+
+    /**
+     * @brief Returns the ids of all records ordered by timestamp.
+     *
+     * Records with equal timestamps keep their load order.
+     *
+     * @return The record ids in timestamp order.
+     */
+    const std::vector<RecordId>& getTimestampIndex() const;
+
+    /**
+     * @brief Finds the records of a time window using the timestamp index.
+     *
+     * @param start The start of the window in minutes since 1 January 1970.
+     * @param end The end of the window (exclusive).
+     * @return The first and one-past-last positions of the window in getTimestampIndex().
+     */
+    std::pair<size_t, size_t> findTimeRange(long long start, long long end) const;
+
+    /**
+     * @brief Returns the memory used by the records and the built indexes.
+     *
+     * @return The number of bytes.
+     */
+    size_t getMemoryBytes() const;
+
+private:
+    /**
+     * @brief Brings the ordered view up to date by radix-sorting the keys of the ids added
+     * since it was built and merging them in.
+     */
+    void extendOrderedIndex() const;
+
+    /**
+     * @brief Brings an index up to date by sorting the ids added since it was built and merging them in.
+     *
+     * New ids are sorted as packed (key, id) pairs with ParallelSort.
+     * @param index The index.
+     * @param less The order of the index.
+     */
+    template <class Less>
+    void extendIndex(std::vector<RecordId>& index, Less less) const;
+
+    Vector<WindTempSolar> records;                  /**< The records in load order. */
+    ValidityMask validity[WindTempSolar::FIELD_COUNT]; /**< Validity bitmap of each field. */
+    mutable std::vector<RecordId> orderedIndex;     /**< Ids in WindTempSolar::operator< order. */
+    mutable std::vector<RecordId> timestampIndex;   /**< Ids in timestamp order. */
+    mutable Bst<WindTempSolar> tree;                /**< Tree of the distinct records, built on demand. */
+    mutable int treeCount;                          /**< Number of records the tree was built from. */
+    mutable std::mutex indexMutex;                  /**< Guards building the indexes. */
+};
+
+#endif // RECORDSTORE_H
@@ -0,0 +1,246 @@
+#include "ReportWriter.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace {
+const unsigned char BINARY_VERSION = 1;
+const int MAX_PRECISION = 50;
+}
+
+// Constructor creates a writer to an existing stream
+ReportWriter::ReportWriter(std::ostream& out, Format format, size_t bufferSize)
+    : out(&out), format(format), buffer(bufferSize > 0 ? bufferSize : 1), used(0), flushed(0),
+      field(0), rows(0), started(false), finished(false) {}
+
+// Constructor creates a writer to a file
+ReportWriter::ReportWriter(const std::string& filename, Format format, size_t bufferSize)
+    : file(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc), out(&file), format(format),
+      buffer(bufferSize > 0 ? bufferSize : 1), used(0), flushed(0), field(0), rows(0), started(false), finished(false) {}
+
+// Destructor completes the report
+ReportWriter::~ReportWriter() {
+    finish();
+}
+
+// Parses a format name
+bool ReportWriter::parseFormat(const std::string& name, Format& format) {
+    if (name == "csv") format = CSV;
+    else if (name == "json") format = JSON;
+    else if (name == "binary") format = BINARY;
+    else return false;
+    return true;
+}
+
+// Checks whether the output is usable
+bool ReportWriter::isOpen() const {
+    return out->good() && (out != &file || file.is_open());
+}
+
+// Writes the header of the report
+void ReportWriter::setColumns(const std::vector<std::string>& names) {
+    columns = names;
+    started = true;
+    if (format == CSV) {
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (i > 0) append(",", 1);
+            append(names[i].data(), names[i].size());
+        }
+        if (!names.empty()) append("\n", 1);
+    } else if (format == JSON) {
+        append("[", 1);
+    } else {
+        append("WTSR", 4);
+        appendLittleEndian(BINARY_VERSION, 1);
+        appendLittleEndian(names.size(), 2);
+        for (size_t i = 0; i < names.size(); ++i) {
+            appendLittleEndian(names[i].size(), 2);
+            append(names[i].data(), names[i].size());
+        }
+    }
+}
+
+// Starts a new row
+void ReportWriter::beginRow() {
+    if (!started) setColumns(std::vector<std::string>());
+    if (format == JSON) {
+        append(rows > 0 ? ",\n{" : "\n{", rows > 0 ? 3 : 2);
+    } else if (format == BINARY) {
+        append("R", 1);
+    }
+    field = 0;
+    rows++;
+}
+
+// Adds a text field
+void ReportWriter::addText(const std::string& value) {
+    beginField();
+    if (format == CSV) {
+        if (value.find_first_of(",\"\n\r") == std::string::npos) {
+            append(value.data(), value.size());
+        } else {
+            // Quote the field and double any quotes inside it
+            append("\"", 1);
+            for (size_t i = 0; i < value.size(); ++i) {
+                if (value[i] == '"') append("\"", 1);
+                append(&value[i], 1);
+            }
+            append("\"", 1);
+        }
+    } else if (format == JSON) {
+        appendJsonString(value);
+    } else {
+        append("s", 1);
+        appendLittleEndian(value.size(), 4);
+        append(value.data(), value.size());
+    }
+}
+
+// Adds an integer field
+void ReportWriter::addInteger(long long value) {
+    beginField();
+    if (format == BINARY) {
+        append("i", 1);
+        appendLittleEndian((unsigned long long)value, 8);
+    } else {
+        writeInteger(value);
+    }
+}
+
+// Adds a float field
+void ReportWriter::addFloat(float value, int precision) {
+    beginField();
+    if (format == BINARY) {
+        unsigned int bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        append("f", 1);
+        appendLittleEndian(bits, 4);
+    } else if (std::isnan(value) || std::isinf(value)) {
+        // Neither CSV nor JSON has a portable spelling for these
+        if (format == JSON) append("null", 4);
+    } else {
+        writeFloat(value, precision);
+    }
+}
+
+// Ends the current row
+void ReportWriter::endRow() {
+    if (format == CSV) {
+        append("\n", 1);
+    } else if (format == JSON) {
+        append("}", 1);
+    }
+}
+
+// Writes text as is
+void ReportWriter::writeText(const std::string& text) {
+    append(text.data(), text.size());
+}
+
+// Writes an integer as text
+void ReportWriter::writeInteger(long long value) {
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    append(digits, result.ptr - digits);
+}
+
+// Writes a float as text, either with fixed decimals or as the shortest exact text
+void ReportWriter::writeFloat(float value, int precision) {
+    char digits[64 + MAX_PRECISION];
+    std::to_chars_result result;
+    if (precision < 0) {
+        result = std::to_chars(digits, digits + sizeof(digits), value);
+    } else {
+        result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed,
+                               precision < MAX_PRECISION ? precision : MAX_PRECISION);
+    }
+    append(digits, result.ptr - digits);
+}
+
+// Completes the report and flushes the buffer
+bool ReportWriter::finish() {
+    if (!finished) {
+        finished = true;
+        if (format == JSON) {
+            if (!started) setColumns(std::vector<std::string>());
+            append(rows > 0 ? "\n]\n" : "]\n", rows > 0 ? 3 : 2);
+        }
+        flush();
+        out->flush();
+    }
+    return out->good();
+}
+
+// Returns the number of bytes produced so far
+unsigned long long ReportWriter::getBytesWritten() const {
+    return flushed + used;
+}
+
+// Appends bytes, writing large blocks straight through when the buffer cannot hold them
+void ReportWriter::append(const char* data, size_t size) {
+    if (used + size > buffer.size()) {
+        flush();
+        if (size > buffer.size()) {
+            out->write(data, size);
+            flushed += size;
+            return;
+        }
+    }
+    std::memcpy(buffer.data() + used, data, size);
+    used += size;
+}
+
+// Appends the low bytes of a value, least significant first
+void ReportWriter::appendLittleEndian(unsigned long long value, size_t size) {
+    char bytes[8];
+    for (size_t i = 0; i < size; ++i) {
+        bytes[i] = (char)((value >> (8 * i)) & 0xFF);
+    }
+    append(bytes, size);
+}
+
+// Writes the separator, or for JSON the key, before a field
+void ReportWriter::beginField() {
+    if (format == CSV) {
+        if (field > 0) append(",", 1);
+    } else if (format == JSON) {
+        if (field > 0) append(",", 1);
+        if (field < columns.size()) {
+            appendJsonString(columns[field]);
+        } else {
+            appendJsonString("field" + std::to_string(field));
+        }
+        append(":", 1);
+    }
+    field++;
+}
+
+// Writes a quoted JSON string, escaping quotes, backslashes and control characters
+void ReportWriter::appendJsonString(const std::string& text) {
+    append("\"", 1);
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = (unsigned char)text[i];
+        if (c == '"' || c == '\\') {
+            char escaped[2] = { '\\', (char)c };
+            append(escaped, 2);
+        } else if (c < 0x20) {
+            char escaped[7];
+            const char* hex = "0123456789abcdef";
+            escaped[0] = '\\'; escaped[1] = 'u'; escaped[2] = '0'; escaped[3] = '0';
+            escaped[4] = hex[c >> 4]; escaped[5] = hex[c & 0xF]; escaped[6] = 0;
+            append(escaped, 6);
+        } else {
+            append(&text[i], 1);
+        }
+    }
+    append("\"", 1);
+}
+
+// Hands the buffered bytes to the stream
+void ReportWriter::flush() {
+    if (used > 0) {
+        out->write(buffer.data(), used);
+        flushed += used;
+        used = 0;
+    }
+}
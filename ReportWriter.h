@@ -0,0 +1,195 @@
+#ifndef REPORTWRITER_H
+#define REPORTWRITER_H
+
+#include <cstddef>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Buffered writer for reports in CSV, JSON or binary form.
+ *
+ * Output is collected in a large buffer and handed to the stream in big blocks, and
+ * numbers are formatted with std::to_chars instead of stream formatting. Reports are
+ * written as a header (setColumns) followed by rows of fields; free-form text can be
+ * written with the write* functions for reports with their own layout.
+ *
+ * The binary format starts with the magic "WTSR", a format version byte and the column
+ * names (uint16 count, then uint16 length and bytes per name). Each row starts with the
+ * byte 'R' and each field is a type byte followed by its value in little-endian order:
+ * 'f' float32, 'i' int64, or 's' uint32 length and bytes.
+ */
+class ReportWriter {
+public:
+    /**
+     * @brief The supported output formats.
+     */
+    enum Format {
+        CSV,    /**< Comma-separated values with a header line. */
+        JSON,   /**< An array with one object per row. */
+        BINARY  /**< Typed little-endian fields, see the class description. */
+    };
+
+    /**
+     * @brief Constructs a writer to a stream.
+     *
+     * @param out The stream to write to; it must outlive the writer.
+     * @param format The output format.
+     * @param bufferSize The size of the output buffer in bytes.
+     */
+    ReportWriter(std::ostream& out, Format format = CSV, size_t bufferSize = 1 << 16);
+
+    /**
+     * @brief Constructs a writer to a file, replacing its contents.
+     *
+     * @param filename The name of the file.
+     * @param format The output format.
+     * @param bufferSize The size of the output buffer in bytes.
+     */
+    ReportWriter(const std::string& filename, Format format = CSV, size_t bufferSize = 1 << 16);
+
+    /**
+     * @brief Finishes the report if finish() has not been called.
+     */
+    ~ReportWriter();
+
+    /**
+     * @brief Parses a format name ("csv", "json" or "binary").
+     *
+     * @param name The name of the format.
+     * @param format Receives the format.
+     * @return true if the name is known, false otherwise.
+     */
+    static bool parseFormat(const std::string& name, Format& format);
+
+    /**
+     * @brief Checks whether the output could be opened.
+     *
+     * @return true if the writer has a usable output, false otherwise.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Writes the header of a report with the given columns.
+     *
+     * @param names The column names.
+     */
+    void setColumns(const std::vector<std::string>& names);
+
+    /**
+     * @brief Starts a new row.
+     */
+    void beginRow();
+
+    /**
+     * @brief Adds a text field to the current row.
+     *
+     * @param value The text.
+     */
+    void addText(const std::string& value);
+
+    /**
+     * @brief Adds an integer field to the current row.
+     *
+     * @param value The integer.
+     */
+    void addInteger(long long value);
+
+    /**
+     * @brief Adds a float field to the current row.
+     *
+     * @param value The value; NaN is written as an empty CSV field or a JSON null.
+     * @param precision The number of decimals, or -1 for the shortest text that reads back exactly.
+     */
+    void addFloat(float value, int precision = -1);
+
+    /**
+     * @brief Ends the current row.
+     */
+    void endRow();
+
+    /**
+     * @brief Writes text as is.
+     *
+     * @param text The text.
+     */
+    void writeText(const std::string& text);
+
+    /**
+     * @brief Writes an integer as text.
+     *
+     * @param value The integer.
+     */
+    void writeInteger(long long value);
+
+    /**
+     * @brief Writes a float as text.
+     *
+     * @param value The value.
+     * @param precision The number of decimals, or -1 for the shortest text that reads back exactly.
+     */
+    void writeFloat(float value, int precision = -1);
+
+    /**
+     * @brief Completes the report and flushes all buffered output.
+     *
+     * @return true if everything was written, false if the output failed.
+     */
+    bool finish();
+
+    /**
+     * @brief Returns the number of bytes produced so far, including buffered bytes.
+     *
+     * @return The number of bytes.
+     */
+    unsigned long long getBytesWritten() const;
+
+private:
+    ReportWriter(const ReportWriter&);
+    ReportWriter& operator=(const ReportWriter&);
+
+    /**
+     * @brief Appends bytes to the buffer, flushing it when full.
+     * @param data The bytes.
+     * @param size The number of bytes.
+     */
+    void append(const char* data, size_t size);
+
+    /**
+     * @brief Appends a value in little-endian byte order.
+     * @param value The value.
+     * @param size The number of bytes to write.
+     */
+    void appendLittleEndian(unsigned long long value, size_t size);
+
+    /**
+     * @brief Writes the separator or key that precedes the next field of a row.
+     */
+    void beginField();
+
+    /**
+     * @brief Writes a string as a quoted JSON string.
+     * @param text The string.
+     */
+    void appendJsonString(const std::string& text);
+
+    /**
+     * @brief Hands the buffered bytes to the stream.
+     */
+    void flush();
+
+    std::ofstream file;                 /**< The file when writing to a file. */
+    std::ostream* out;                  /**< The stream written to. */
+    Format format;                      /**< The output format. */
+    std::vector<char> buffer;           /**< Bytes not yet handed to the stream. */
+    size_t used;                        /**< Number of bytes used in the buffer. */
+    unsigned long long flushed;         /**< Number of bytes handed to the stream. */
+    std::vector<std::string> columns;   /**< Column names. */
+    size_t field;                       /**< Index of the next field in the current row. */
+    long long rows;                     /**< Number of rows started. */
+    bool started;                       /**< Set once the header has been written. */
+    bool finished;                      /**< Set once finish() has run. */
+};
+
+#endif // REPORTWRITER_H
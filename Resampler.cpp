@@ -0,0 +1,67 @@
+#include "Resampler.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+// Orders buckets by start time
+bool bucketLess(const SeriesBucket& a, const SeriesBucket& b) {
+    return a.start < b.start;
+}
+
+// Returns the start of the bucket containing the timestamp, rounding towards the past
+long long bucketStart(long long timestamp, long long bucketMinutes) {
+    long long start = timestamp - timestamp % bucketMinutes;
+    return (start > timestamp) ? start - bucketMinutes : start;
+}
+}
+
+// Aggregates the records into fixed buckets in one pass
+SeriesStore Resampler::resample(const Vector<WindTempSolar>& data, long long bucketMinutes) {
+    SeriesStore store(bucketMinutes);
+    if (bucketMinutes <= 0 || data.size() == 0) return store;
+
+    std::vector<SeriesBucket> buckets;
+    bool ordered = true;
+    SeriesBucket current = SeriesBucket::empty(bucketStart(data[0].getTimestamp(), bucketMinutes));
+
+    for (int i = 0; i < data.size(); ++i) {
+        const WindTempSolar& record = data[i];
+        long long start = bucketStart(record.getTimestamp(), bucketMinutes);
+        if (start != current.start) {
+            // The record belongs to another bucket, so the current one is complete
+            if (start < current.start) ordered = false;
+            buckets.push_back(current);
+            current = SeriesBucket::empty(start);
+        }
+        for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+            // Invalid values are left out of the sums, as in the summaries
+            float value = record.getValue(f);
+            if (!std::isnan(value)) {
+                current.sum[f] += value;
+                current.validCount[f]++;
+            }
+        }
+        current.count++;
+    }
+    buckets.push_back(current);
+
+    if (!ordered) {
+        // Bring out-of-order buckets together and combine buckets with the same start
+        std::stable_sort(buckets.begin(), buckets.end(), bucketLess);
+        std::vector<SeriesBucket> combined;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            if (!combined.empty() && combined.back().start == buckets[i].start) {
+                combined.back().merge(buckets[i]);
+            } else {
+                combined.push_back(buckets[i]);
+            }
+        }
+        buckets.swap(combined);
+    }
+
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        store.append(buckets[i]);
+    }
+    return store;
+}
@@ -0,0 +1,35 @@
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include "Vector.h"
+#include "WindTempSolar.h"
+#include "SeriesStore.h"
+
+/**
+ * @brief The Resampler class aggregates records into fixed time buckets.
+ *
+ * Time-ordered records are aggregated in a single streaming pass: a bucket is emitted as
+ * soon as a record from a later bucket arrives. Records that arrive out of order are still
+ * aggregated correctly, at the cost of a final sort of the buckets.
+ */
+class Resampler {
+public:
+    /** Length of an hourly bucket in minutes. */
+    static const long long HOURLY = 60;
+    /** Length of a daily bucket in minutes. */
+    static const long long DAILY = 24 * 60;
+
+    /**
+     * @brief Resample the records into buckets of the given length.
+     *
+     * Buckets start at multiples of the bucket length since 1 January 1970, so daily buckets
+     * start at midnight. Only buckets containing at least one record are stored.
+     *
+     * @param data Vector of WindTempSolar objects, ideally ordered by time.
+     * @param bucketMinutes The length of each bucket in minutes.
+     * @return The resampled series.
+     */
+    static SeriesStore resample(const Vector<WindTempSolar>& data, long long bucketMinutes);
+};
+
+#endif // RESAMPLER_H
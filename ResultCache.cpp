@@ -0,0 +1,73 @@
+#include "ResultCache.h"
+
+// Constructor creates an empty cache with the given capacity
+ResultCache::ResultCache(size_t capacity) : capacity(capacity), generation(0), hits(0), misses(0) {}
+
+// Looks up a result and marks it as most recently used
+bool ResultCache::lookup(const std::string& key, unsigned long long generation, float& value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    checkGeneration(generation);
+    std::unordered_map<std::string, EntryList::iterator>::iterator it = index.find(key);
+    if (it == index.end()) {
+        misses++;
+        return false;
+    }
+    // Move the entry to the front of the list
+    entries.splice(entries.begin(), entries, it->second);
+    value = it->second->second;
+    hits++;
+    return true;
+}
+
+// Stores a result, evicting the least recently used entry when full
+void ResultCache::store(const std::string& key, unsigned long long generation, float value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    checkGeneration(generation);
+    if (capacity == 0) return;
+    std::unordered_map<std::string, EntryList::iterator>::iterator it = index.find(key);
+    if (it != index.end()) {
+        it->second->second = value;
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+    if (entries.size() >= capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+    entries.push_front(std::make_pair(key, value));
+    index[key] = entries.begin();
+}
+
+// Removes all cached results
+void ResultCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+}
+
+// Returns the number of cache hits
+unsigned long long ResultCache::getHits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+// Returns the number of cache misses
+unsigned long long ResultCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+// Returns the number of cached results
+size_t ResultCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+// Drops all results computed from an older dataset generation; the caller holds the lock
+void ResultCache::checkGeneration(unsigned long long generation) {
+    if (generation != this->generation) {
+        entries.clear();
+        index.clear();
+        this->generation = generation;
+    }
+}
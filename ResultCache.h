@@ -0,0 +1,89 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief Bounded least-recently-used cache of query results.
+ *
+ * Results are stored under a string key together with the dataset generation they were
+ * computed from. When a lookup is made with a different generation, the whole cache is
+ * discarded, so results never outlive the data they were computed from. All operations
+ * are guarded by a mutex, so one cache can be shared by concurrent queries.
+ */
+class ResultCache {
+public:
+    /**
+     * @brief Constructs a cache holding at most the given number of results.
+     *
+     * @param capacity The maximum number of cached results.
+     */
+    ResultCache(size_t capacity = 1024);
+
+    /**
+     * @brief Looks up a cached result.
+     *
+     * @param key The key of the query.
+     * @param generation The current dataset generation.
+     * @param value Receives the cached result if found.
+     * @return true if the result was found, false otherwise.
+     */
+    bool lookup(const std::string& key, unsigned long long generation, float& value);
+
+    /**
+     * @brief Stores a result, evicting the least recently used result if the cache is full.
+     *
+     * @param key The key of the query.
+     * @param generation The dataset generation the result was computed from.
+     * @param value The result to store.
+     */
+    void store(const std::string& key, unsigned long long generation, float value);
+
+    /**
+     * @brief Removes all cached results.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of lookups that found a result.
+     *
+     * @return The number of cache hits.
+     */
+    unsigned long long getHits() const;
+
+    /**
+     * @brief Returns the number of lookups that did not find a result.
+     *
+     * @return The number of cache misses.
+     */
+    unsigned long long getMisses() const;
+
+    /**
+     * @brief Returns the number of cached results.
+     *
+     * @return The number of cached results.
+     */
+    size_t size() const;
+
+private:
+    typedef std::list<std::pair<std::string, float> > EntryList;
+
+    /**
+     * @brief Discards all results if they belong to an older generation.
+     */
+    void checkGeneration(unsigned long long generation);
+
+    size_t capacity;                                                /**< Maximum number of results. */
+    unsigned long long generation;                                  /**< Generation of the cached results. */
+    EntryList entries;                                              /**< Results, most recently used first. */
+    std::unordered_map<std::string, EntryList::iterator> index;     /**< Key to entry lookup. */
+    unsigned long long hits;                                        /**< Number of cache hits. */
+    unsigned long long misses;                                      /**< Number of cache misses. */
+    mutable std::mutex mutex;                                       /**< Guards all members above. */
+};
+
+#endif // RESULTCACHE_H
@@ -0,0 +1,28 @@
+#include "RollingStatistics.h"
+#include "RollingWindow.h"
+
+// Calculates the statistics of every window length in one pass over the records in timestamp order
+std::vector<std::vector<RollingPoint> > RollingStatistics::calculate(const RecordStore& store, const std::string& field, const std::vector<long long>& durations) {
+    std::vector<std::vector<RollingPoint> > series(durations.size());
+    int fieldIndex = WindTempSolar::getFieldIndex(field);
+    if (fieldIndex < 0) return series;
+
+    const std::vector<RecordStore::RecordId>& index = store.getTimestampIndex();
+    std::vector<RollingWindow> windows;
+    for (size_t w = 0; w < durations.size(); ++w) {
+        windows.push_back(RollingWindow(durations[w]));
+        series[w].reserve(index.size());
+    }
+
+    for (size_t i = 0; i < index.size(); ++i) {
+        const WindTempSolar& record = store[index[i]];
+        long long timestamp = record.getTimestamp();
+        float value = record.getValue(fieldIndex);
+        for (size_t w = 0; w < windows.size(); ++w) {
+            windows[w].push(timestamp, value);
+            RollingPoint point = { timestamp, windows[w].getCount(), windows[w].getMean(), windows[w].getVariance(), windows[w].getMin(), windows[w].getMax() };
+            series[w].push_back(point);
+        }
+    }
+    return series;
+}
@@ -0,0 +1,48 @@
+#ifndef ROLLINGSTATISTICS_H
+#define ROLLINGSTATISTICS_H
+
+#include "RecordStore.h"
+#include "WindTempSolar.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Statistics of one rolling window, taken at the timestamp of a record.
+ */
+struct RollingPoint {
+    long long timestamp;    ///< Timestamp of the record that ends the window, in minutes
+    long long count;        ///< Number of valid values in the window
+    float mean;             ///< Mean of the values in the window
+    float variance;         ///< Variance of the values in the window
+    float min;              ///< Minimum of the values in the window
+    float max;              ///< Maximum of the values in the window
+};
+
+/**
+ * @brief The RollingStatistics class computes sliding-window statistics over time-ordered records.
+ *
+ * Any number of window lengths are evaluated together in a single pass over the data, with
+ * each window updated in O(1) per record by a RollingWindow. The records are visited through the
+ * store's timestamp index, so files may be loaded in any order.
+ */
+class RollingStatistics {
+public:
+    /** Length of a one-hour window in minutes. */
+    static const long long HOUR = 60;
+    /** Length of a one-day window in minutes. */
+    static const long long DAY = 24 * 60;
+    /** Length of a 30-day window in minutes. */
+    static const long long MONTH = 30 * 24 * 60;
+
+    /**
+     * @brief Calculate rolling statistics of a field for several window lengths.
+     *
+     * @param store The record store; its records are visited in timestamp order.
+     * @param field The field to aggregate (e.g., "wind_speed").
+     * @param durations The window lengths in minutes.
+     * @return For each window length, one RollingPoint per record, in timestamp order.
+     */
+    static std::vector<std::vector<RollingPoint> > calculate(const RecordStore& store, const std::string& field, const std::vector<long long>& durations);
+};
+
+#endif // ROLLINGSTATISTICS_H
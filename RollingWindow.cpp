@@ -0,0 +1,85 @@
+#include "RollingWindow.h"
+#include <climits>
+#include <cmath>
+
+// Constructor creates an empty window of the given length
+RollingWindow::RollingWindow(long long duration) : duration(duration), latest(LLONG_MIN), sum(0), sumSquares(0) {}
+
+// Adds a valid value, then evicts everything that is no longer inside the window
+void RollingWindow::push(long long timestamp, float value) {
+    if (timestamp < latest) {
+        clear();
+    }
+    latest = timestamp;
+    if (!std::isfinite(value)) {
+        // A missing value moves the window on without entering it
+        evict(timestamp);
+        return;
+    }
+
+    entries.push_back(Entry(timestamp, value));
+    sum += value;
+    sumSquares += (double)value * value;
+    // Values that can never be the minimum (or maximum) again are dropped from the deques
+    while (!minimums.empty() && minimums.back().second >= value) minimums.pop_back();
+    minimums.push_back(Entry(timestamp, value));
+    while (!maximums.empty() && maximums.back().second <= value) maximums.pop_back();
+    maximums.push_back(Entry(timestamp, value));
+    evict(timestamp);
+}
+
+// Drops the values at or before the start of the window ending at a timestamp
+void RollingWindow::evict(long long timestamp) {
+    long long oldest = timestamp - duration;
+    while (!entries.empty() && entries.front().first <= oldest) {
+        sum -= entries.front().second;
+        sumSquares -= (double)entries.front().second * entries.front().second;
+        entries.pop_front();
+    }
+    while (!minimums.empty() && minimums.front().first <= oldest) minimums.pop_front();
+    while (!maximums.empty() && maximums.front().first <= oldest) maximums.pop_front();
+}
+
+// Removes all values from the window
+void RollingWindow::clear() {
+    entries.clear();
+    minimums.clear();
+    maximums.clear();
+    latest = LLONG_MIN;
+    sum = 0;
+    sumSquares = 0;
+}
+
+// Returns the length of the window in minutes
+long long RollingWindow::getDuration() const {
+    return duration;
+}
+
+// Returns the number of values in the window
+long long RollingWindow::getCount() const {
+    return (long long)entries.size();
+}
+
+// Returns the mean of the values in the window
+float RollingWindow::getMean() const {
+    return entries.empty() ? 0 : (float)(sum / entries.size());
+}
+
+// Returns the variance of the values in the window
+float RollingWindow::getVariance() const {
+    if (entries.empty()) return 0;
+    double mean = sum / entries.size();
+    double variance = sumSquares / entries.size() - mean * mean;
+    // Guard against small negative values caused by rounding
+    return (variance > 0) ? (float)variance : 0;
+}
+
+// Returns the minimum of the values in the window
+float RollingWindow::getMin() const {
+    return minimums.empty() ? 0 : minimums.front().second;
+}
+
+// Returns the maximum of the values in the window
+float RollingWindow::getMax() const {
+    return maximums.empty() ? 0 : maximums.front().second;
+}
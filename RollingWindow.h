@@ -0,0 +1,103 @@
+#ifndef ROLLINGWINDOW_H
+#define ROLLINGWINDOW_H
+
+#include <deque>
+#include <utility>
+
+/**
+ * @brief Sliding time window over a stream of timestamped values.
+ *
+ * The window holds the values whose timestamps lie in (latest - duration, latest]. Sums
+ * and sums of squares are updated as values enter and leave, and monotonic deques track
+ * the minimum and maximum, so every push costs amortised O(1) regardless of window size.
+ * Missing (NaN) and infinite values move the window on but are not counted, so the
+ * statistics cover the valid values only.
+ */
+class RollingWindow {
+public:
+    /**
+     * @brief Constructs an empty window.
+     *
+     * @param duration The length of the window in minutes.
+     */
+    RollingWindow(long long duration);
+
+    /**
+     * @brief Adds a value and evicts values that have left the window.
+     *
+     * Timestamps must not decrease; a value older than the previous one restarts the window.
+     * A value that is not finite advances the window without being added to it.
+     *
+     * @param timestamp The timestamp of the value in minutes.
+     * @param value The value to add.
+     */
+    void push(long long timestamp, float value);
+
+    /**
+     * @brief Removes all values from the window.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the length of the window in minutes.
+     *
+     * @return The window duration.
+     */
+    long long getDuration() const;
+
+    /**
+     * @brief Returns the number of valid values in the window.
+     *
+     * @return The number of valid values.
+     */
+    long long getCount() const;
+
+    /**
+     * @brief Returns the mean of the values in the window.
+     *
+     * @return The mean, or 0 if the window is empty.
+     */
+    float getMean() const;
+
+    /**
+     * @brief Returns the variance of the values in the window.
+     *
+     * The variance is computed with a divisor of n, like Math::calculateStandardDeviation.
+     *
+     * @return The variance, or 0 if the window is empty.
+     */
+    float getVariance() const;
+
+    /**
+     * @brief Returns the minimum of the values in the window.
+     *
+     * @return The minimum, or 0 if the window is empty.
+     */
+    float getMin() const;
+
+    /**
+     * @brief Returns the maximum of the values in the window.
+     *
+     * @return The maximum, or 0 if the window is empty.
+     */
+    float getMax() const;
+
+private:
+    typedef std::pair<long long, float> Entry;
+
+    /**
+     * @brief Evicts the values that have left the window ending at a timestamp.
+     * @param timestamp The end of the window in minutes.
+     */
+    void evict(long long timestamp);
+
+    long long duration;             /**< Length of the window in minutes. */
+    long long latest;               /**< Timestamp of the latest push, valid or not. */
+    std::deque<Entry> entries;      /**< Values in the window, oldest first. */
+    std::deque<Entry> minimums;     /**< Increasing candidates for the minimum. */
+    std::deque<Entry> maximums;     /**< Decreasing candidates for the maximum. */
+    double sum;                     /**< Sum of the values in the window. */
+    double sumSquares;              /**< Sum of the squared values in the window. */
+};
+
+#endif // ROLLINGWINDOW_H
@@ -0,0 +1,94 @@
+#include "SeriesStore.h"
+
+// Returns the mean of a field over the bucket
+float SeriesBucket::getMean(int fieldIndex) const {
+    if (fieldIndex < 0 || fieldIndex >= WindTempSolar::FIELD_COUNT || validCount[fieldIndex] == 0) return 0;
+    return (float)(sum[fieldIndex] / validCount[fieldIndex]);
+}
+
+// Adds the counts and sums of another bucket
+void SeriesBucket::merge(const SeriesBucket& other) {
+    count += other.count;
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+        validCount[f] += other.validCount[f];
+        sum[f] += other.sum[f];
+    }
+}
+
+// Creates an empty bucket starting at the given time
+SeriesBucket SeriesBucket::empty(long long start) {
+    SeriesBucket bucket;
+    bucket.start = start;
+    bucket.count = 0;
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+        bucket.validCount[f] = 0;
+        bucket.sum[f] = 0;
+    }
+    return bucket;
+}
+
+// Constructor creates an empty series with the given bucket length
+SeriesStore::SeriesStore(long long bucketMinutes) : bucketMinutes(bucketMinutes) {}
+
+// Appends a bucket to the end of the series
+void SeriesStore::append(const SeriesBucket& bucket) {
+    buckets.push_back(bucket);
+}
+
+// Returns the length of each bucket in minutes
+long long SeriesStore::getBucketMinutes() const {
+    return bucketMinutes;
+}
+
+// Returns the number of buckets
+int SeriesStore::size() const {
+    return (int)buckets.size();
+}
+
+// Accesses a bucket by position
+const SeriesBucket& SeriesStore::operator[](int index) const {
+    return buckets[index];
+}
+
+// Combines the buckets starting in [start, end)
+SeriesBucket SeriesStore::getAggregate(long long start, long long end) const {
+    SeriesBucket aggregate = SeriesBucket::empty(start);
+    for (int i = lowerBound(start); i < size() && buckets[i].start < end; ++i) {
+        aggregate.merge(buckets[i]);
+    }
+    return aggregate;
+}
+
+// Returns the number of records in the buckets starting in [start, end)
+long long SeriesStore::getCount(long long start, long long end) const {
+    return getAggregate(start, end).count;
+}
+
+// Returns the mean of a field over the buckets starting in [start, end)
+float SeriesStore::getMean(const std::string& field, long long start, long long end) const {
+    int f = WindTempSolar::getFieldIndex(field);
+    if (f < 0) return 0;
+    return getAggregate(start, end).getMean(f);
+}
+
+// Returns the total of a field over the buckets starting in [start, end)
+float SeriesStore::getTotal(const std::string& field, long long start, long long end) const {
+    int f = WindTempSolar::getFieldIndex(field);
+    if (f < 0) return 0;
+    return (float)getAggregate(start, end).sum[f];
+}
+
+// Binary search for the first bucket starting at or after the timestamp
+int SeriesStore::lowerBound(long long timestamp) const {
+    int low = 0;
+    int high = size();
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (buckets[middle].start < timestamp) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
@@ -0,0 +1,135 @@
+#ifndef SERIESSTORE_H
+#define SERIESSTORE_H
+
+#include "WindTempSolar.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Aggregate of all records that fall into one fixed time bucket.
+ */
+struct SeriesBucket {
+    long long start;                            ///< Start of the bucket in minutes since 1 January 1970
+    long long count;                            ///< Number of records in the bucket
+    long long validCount[WindTempSolar::FIELD_COUNT]; ///< Number of valid (non-NaN) values of each field
+    double sum[WindTempSolar::FIELD_COUNT];     ///< Sum of the valid values of each field
+
+    /**
+     * @brief Returns the mean of a field over the bucket.
+     *
+     * @param fieldIndex The index of the field (see WindTempSolar::getFieldIndex).
+     * @return The mean of the valid values, or 0 if there are none.
+     */
+    float getMean(int fieldIndex) const;
+
+    /**
+     * @brief Adds the counts and sums of another bucket to this one.
+     *
+     * @param other The bucket to add.
+     */
+    void merge(const SeriesBucket& other);
+
+    /**
+     * @brief Returns an empty bucket.
+     *
+     * @param start The start of the bucket in minutes since 1 January 1970.
+     * @return The bucket.
+     */
+    static SeriesBucket empty(long long start);
+};
+
+/**
+ * @brief Compact time series of fixed-length buckets, ordered by start time.
+ *
+ * Each bucket holds the record count and the sum of every field, giving mean wind speed and
+ * temperature and integrated (total) solar radiation per bucket. Queries over a time range
+ * locate the buckets by binary search and combine their sums, so they touch one entry per
+ * hour or day instead of one per raw record.
+ */
+class SeriesStore {
+public:
+    /**
+     * @brief Constructs an empty series.
+     *
+     * @param bucketMinutes The length of each bucket in minutes.
+     */
+    SeriesStore(long long bucketMinutes = 60);
+
+    /**
+     * @brief Appends a bucket. Buckets must be appended in increasing start order.
+     *
+     * @param bucket The bucket to append.
+     */
+    void append(const SeriesBucket& bucket);
+
+    /**
+     * @brief Returns the length of each bucket in minutes.
+     *
+     * @return The bucket length.
+     */
+    long long getBucketMinutes() const;
+
+    /**
+     * @brief Returns the number of buckets.
+     *
+     * @return The number of buckets.
+     */
+    int size() const;
+
+    /**
+     * @brief Accesses a bucket by position.
+     *
+     * @param index The position of the bucket.
+     * @return The bucket.
+     */
+    const SeriesBucket& operator[](int index) const;
+
+    /**
+     * @brief Combines the buckets starting in [start, end) into one.
+     *
+     * @param start The start of the range in minutes.
+     * @param end The end of the range in minutes.
+     * @return A bucket starting at start with the counts and sums of the range.
+     */
+    SeriesBucket getAggregate(long long start, long long end) const;
+
+    /**
+     * @brief Returns the number of records in the buckets starting in [start, end).
+     *
+     * @param start The start of the range in minutes.
+     * @param end The end of the range in minutes.
+     * @return The number of records.
+     */
+    long long getCount(long long start, long long end) const;
+
+    /**
+     * @brief Returns the mean of a field over the buckets starting in [start, end).
+     *
+     * @param field The name of the field (e.g., "wind_speed").
+     * @param start The start of the range in minutes.
+     * @param end The end of the range in minutes.
+     * @return The mean of the valid values, or 0 if there are none or the field is unknown.
+     */
+    float getMean(const std::string& field, long long start, long long end) const;
+
+    /**
+     * @brief Returns the total of a field over the buckets starting in [start, end).
+     *
+     * @param field The name of the field (e.g., "solar_radiation").
+     * @param start The start of the range in minutes.
+     * @param end The end of the range in minutes.
+     * @return The total, or 0 if the field is unknown.
+     */
+    float getTotal(const std::string& field, long long start, long long end) const;
+
+private:
+    /**
+     * @brief Returns the position of the first bucket starting at or after a time.
+     */
+    int lowerBound(long long timestamp) const;
+
+    long long bucketMinutes;            /**< Length of each bucket in minutes. */
+    std::vector<SeriesBucket> buckets;  /**< Buckets ordered by start time. */
+};
+
+#endif // SERIESSTORE_H
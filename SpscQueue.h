@@ -0,0 +1,98 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * The queue is a ring buffer whose capacity is rounded up to a power of two. The producer
+ * only writes the tail index and the consumer only writes the head index, so neither side
+ * takes a lock; each index is on its own cache line to avoid false sharing.
+ *
+ * @tparam T The type of elements passed through the queue.
+ */
+template <class T>
+class SpscQueue {
+public:
+    /**
+     * @brief Constructs an empty queue.
+     *
+     * @param capacity The minimum number of elements the queue can hold.
+     */
+    SpscQueue(size_t capacity);
+
+    /**
+     * @brief Adds an element if there is room. Called by the producer only.
+     *
+     * @param value The element; it is moved from only if the call succeeds.
+     * @return true if the element was added, false if the queue is full.
+     */
+    bool tryPush(T& value);
+
+    /**
+     * @brief Removes the oldest element if there is one. Called by the consumer only.
+     *
+     * @param value Receives the element.
+     * @return true if an element was removed, false if the queue is empty.
+     */
+    bool tryPop(T& value);
+
+    /**
+     * @brief Returns the number of elements the queue can hold.
+     *
+     * @return The capacity.
+     */
+    size_t capacity() const;
+
+private:
+    SpscQueue(const SpscQueue&);
+    SpscQueue& operator=(const SpscQueue&);
+
+    std::vector<T> slots;                       /**< Ring buffer of elements. */
+    size_t mask;                                /**< Capacity minus one, for wrapping indexes. */
+    alignas(64) std::atomic<size_t> head;       /**< Next slot to read; written by the consumer. */
+    alignas(64) std::atomic<size_t> tail;       /**< Next slot to write; written by the producer. */
+};
+
+// Implementation
+
+template <class T>
+SpscQueue<T>::SpscQueue(size_t capacity) : head(0), tail(0) {
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    slots.resize(size);
+    mask = size - 1;
+}
+
+template <class T>
+bool SpscQueue<T>::tryPush(T& value) {
+    size_t position = tail.load(std::memory_order_relaxed);
+    if (position - head.load(std::memory_order_acquire) > mask) {
+        return false; // Full
+    }
+    slots[position & mask] = std::move(value);
+    tail.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <class T>
+bool SpscQueue<T>::tryPop(T& value) {
+    size_t position = head.load(std::memory_order_relaxed);
+    if (position == tail.load(std::memory_order_acquire)) {
+        return false; // Empty
+    }
+    value = std::move(slots[position & mask]);
+    head.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <class T>
+size_t SpscQueue<T>::capacity() const {
+    return slots.size();
+}
+
+#endif // SPSCQUEUE_H
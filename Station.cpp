@@ -0,0 +1,48 @@
+#include "Station.h"
+
+// Constructor creates an empty station whose calculator refers to its store
+Station::Station(int id, const std::string& name, long long sampleMinutes)
+    : id(id), name(name), cube(sampleMinutes), calculator(store, cube) {}
+
+// Adds a record to the store and the summaries of the station
+void Station::add(const WindTempSolar& record) {
+    WindTempSolar stamped(record);
+    stamped.setStationId(id);
+    store.add(stamped);
+    cube.add(stamped);
+}
+
+// Returns the identifier of the station
+int Station::getId() const {
+    return id;
+}
+
+// Returns the name of the station
+const std::string& Station::getName() const {
+    return name;
+}
+
+// Returns the number of records of the station
+int Station::getRecordCount() const {
+    return store.size();
+}
+
+// Returns the records of the station
+const Vector<WindTempSolar>& Station::getData() const {
+    return store.getRecords();
+}
+
+// Returns the record store of the station
+const RecordStore& Station::getStore() const {
+    return store;
+}
+
+// Returns the per-month summaries of the station
+const SummaryCube& Station::getCube() const {
+    return cube;
+}
+
+// Returns the calculator of the station
+const CalcResults& Station::getCalculator() const {
+    return calculator;
+}
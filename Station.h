@@ -0,0 +1,97 @@
+#ifndef STATION_H
+#define STATION_H
+
+#include "Vector.h"
+#include "RecordStore.h"
+#include "WindTempSolar.h"
+#include "SummaryCube.h"
+#include "CalcResults.h"
+#include <string>
+
+/**
+ * @brief The data partition of a single weather station.
+ *
+ * A station owns its records in a single RecordStore, its SummaryCube, and a CalcResults
+ * answering queries over them. Ordered and timestamp views of the records are secondary
+ * indexes of the store, built only when needed. Stations are not copyable because the
+ * calculator refers to the station's store.
+ */
+class Station {
+public:
+    /**
+     * @brief Constructs an empty station.
+     *
+     * @param id The identifier of the station.
+     * @param name The name of the station.
+     * @param sampleMinutes The logging interval of the station in minutes, or 0 to infer it from the timestamps.
+     */
+    Station(int id, const std::string& name, long long sampleMinutes = 0);
+
+    /**
+     * @brief Adds a record to the station, stamping it with the station's identifier.
+     *
+     * @param record The record to add.
+     */
+    void add(const WindTempSolar& record);
+
+    /**
+     * @brief Returns the identifier of the station.
+     *
+     * @return The station identifier.
+     */
+    int getId() const;
+
+    /**
+     * @brief Returns the name of the station.
+     *
+     * @return The station name.
+     */
+    const std::string& getName() const;
+
+    /**
+     * @brief Returns the number of records of the station.
+     *
+     * @return The number of records.
+     */
+    int getRecordCount() const;
+
+    /**
+     * @brief Returns the records of the station in load order.
+     *
+     * @return The records.
+     */
+    const Vector<WindTempSolar>& getData() const;
+
+    /**
+     * @brief Returns the record store of the station, with its secondary indexes.
+     *
+     * @return The record store.
+     */
+    const RecordStore& getStore() const;
+
+    /**
+     * @brief Returns the per-month summaries of the station.
+     *
+     * @return The summary cube.
+     */
+    const SummaryCube& getCube() const;
+
+    /**
+     * @brief Returns the calculator answering queries over the station's data.
+     *
+     * @return The calculator.
+     */
+    const CalcResults& getCalculator() const;
+
+private:
+    Station(const Station&);
+    Station& operator=(const Station&);
+
+    int id;                                         /**< Identifier of the station. */
+    std::string name;                               /**< Name of the station. */
+    RecordStore store;                              /**< Records of the station. */
+    SummaryCube cube;                               /**< Per-month summaries of the station. */
+    CalcResults calculator;                         /**< Queries over the station; declared last as it refers to the members above. */
+};
+
+#endif // STATION_H
@@ -0,0 +1,239 @@
+#include "StationStore.h"
+#include "Percentile.h"
+#include "Profiler.h"
+#include <cmath>
+#include <map>
+
+const char* const StationStore::DEFAULT_STATION = "default";
+
+// Constructor creates an empty store with its worker threads
+StationStore::StationStore(size_t threadCount) : pool(threadCount), cache(1024) {}
+
+// Returns the identifier of the named station, adding it if needed
+int StationStore::addStation(const std::string& name) {
+    int stationId = findStation(name);
+    if (stationId >= 0) return stationId;
+    stationId = (int)stations.size();
+    stations.push_back(std::unique_ptr<Station>(new Station(stationId, name)));
+    return stationId;
+}
+
+// Returns the identifier of the named station, or -1
+int StationStore::findStation(const std::string& name) const {
+    for (size_t i = 0; i < stations.size(); ++i) {
+        if (stations[i]->getName() == name) return (int)i;
+    }
+    return -1;
+}
+
+// Returns the number of stations
+int StationStore::getStationCount() const {
+    return (int)stations.size();
+}
+
+// Returns a station by identifier
+const Station& StationStore::getStation(int stationId) const {
+    return *stations[stationId];
+}
+
+// Adds a record to a station
+void StationStore::add(int stationId, const WindTempSolar& record) {
+    stations[stationId]->add(record);
+}
+
+// Returns the number of records of all stations
+long long StationStore::getRecordCount() const {
+    long long count = 0;
+    for (size_t i = 0; i < stations.size(); ++i) {
+        count += stations[i]->getRecordCount();
+    }
+    return count;
+}
+
+// Evaluates queries for one station, or for all stations by merging per-station partial results
+std::vector<float> StationStore::evaluateBatch(const std::vector<QuerySpec>& queries, int stationId) const {
+    PROFILE_SCOPE("StationStore::evaluateBatch");
+    if (stationId != ALL_STATIONS) {
+        if (stationId < 0 || stationId >= getStationCount()) return std::vector<float>(queries.size(), 0);
+        return stations[stationId]->getCalculator().evaluateBatch(queries);
+    }
+    if (stations.empty()) return std::vector<float>(queries.size(), 0);
+    if (stations.size() == 1) return stations[0]->getCalculator().evaluateBatch(queries);
+
+    // Combined results are cached under the sum of the station generations, which grows with every record added
+    unsigned long long generation = getGeneration();
+    std::vector<float> results(queries.size(), 0);
+    std::vector<size_t> pending;
+    for (size_t q = 0; q < queries.size(); ++q) {
+        if (!cache.lookup(queries[q].toKey(), generation, results[q])) pending.push_back(q);
+    }
+    if (pending.empty()) return results;
+
+    // Compute the mergeable partial results of every station in parallel
+    size_t stationCount = stations.size();
+    std::vector<std::vector<MonthlySummary> > summaries(stationCount, std::vector<MonthlySummary>(pending.size()));
+    std::vector<std::vector<TDigest> > digests(stationCount, std::vector<TDigest>(pending.size()));
+    std::vector<std::vector<SeriesBucket> > windows(stationCount, std::vector<SeriesBucket>(pending.size()));
+    forEachStation([&](int s) {
+        const CalcResults& calculator = stations[s]->getCalculator();
+        for (size_t p = 0; p < pending.size(); ++p) {
+            const QuerySpec& query = queries[pending[p]];
+            if (query.isWindow()) {
+                windows[s][p] = calculator.getWindowAggregate(query);
+            } else if (query.metric == QuerySpec::APPROXIMATE_PERCENTILE) {
+                digests[s][p] = calculator.getDigest(query);
+            } else {
+                summaries[s][p] = calculator.getSummary(query);
+            }
+        }
+    });
+
+    std::vector<MonthlySummary> merged(pending.size());
+    std::vector<QuerySpec> deviationQueries;
+    std::vector<float> deviationCentres;
+    std::vector<size_t> deviationIndex;
+    std::vector<QuerySpec> valueQueries;
+    std::vector<size_t> valueIndex;
+    for (size_t p = 0; p < pending.size(); ++p) {
+        const QuerySpec& query = queries[pending[p]];
+        if (query.isWindow()) {
+            SeriesBucket window = SeriesBucket::empty(query.windowStart);
+            for (size_t s = 0; s < stationCount; ++s) window.merge(windows[s][p]);
+            results[pending[p]] = CalcResults::evaluateWindow(query, window);
+        } else if (query.metric == QuerySpec::APPROXIMATE_PERCENTILE) {
+            TDigest digest;
+            for (size_t s = 0; s < stationCount; ++s) digest.merge(digests[s][p]);
+            results[pending[p]] = digest.getPercentile(query.percentile);
+        } else {
+            for (size_t s = 0; s < stationCount; ++s) merged[p].merge(summaries[s][p]);
+            if (!query.needsScan()) {
+                results[pending[p]] = CalcResults::evaluateSummary(query, merged[p]);
+            } else if (query.metric == QuerySpec::MEAN_ABSOLUTE_DEVIATION) {
+                deviationQueries.push_back(query);
+                deviationCentres.push_back(merged[p].getMean(query.field));
+                deviationIndex.push_back(pending[p]);
+            } else {
+                valueQueries.push_back(query);
+                valueIndex.push_back(pending[p]);
+            }
+        }
+    }
+
+    // Mean absolute deviations around the combined mean: each station sums its deviations in one scan of the period
+    if (!deviationQueries.empty()) {
+        std::vector<std::vector<double> > sums(stationCount);
+        std::vector<std::vector<long long> > counts(stationCount);
+        forEachStation([&](int s) {
+            stations[s]->getCalculator().sumAbsoluteDeviations(deviationQueries, deviationCentres, sums[s], counts[s]);
+        });
+        for (size_t d = 0; d < deviationQueries.size(); ++d) {
+            double sum = 0;
+            long long count = 0;
+            for (size_t s = 0; s < stationCount; ++s) {
+                sum += sums[s][d];
+                count += counts[s][d];
+            }
+            results[deviationIndex[d]] = count == 0 ? 0 : (float)(sum / count);
+        }
+    }
+
+    // Exact order statistics have no mergeable partials, so they gather the values of the queried period only
+    if (!valueQueries.empty()) {
+        std::vector<std::vector<std::vector<float> > > values(stationCount);
+        forEachStation([&](int s) {
+            stations[s]->getCalculator().collectValues(valueQueries, values[s]);
+        });
+        for (size_t v = 0; v < valueQueries.size(); ++v) {
+            size_t total = 0;
+            for (size_t s = 0; s < stationCount; ++s) total += values[s][v].size();
+            std::vector<float> combined;
+            combined.swap(values[0][v]);
+            combined.reserve(total);
+            for (size_t s = 1; s < stationCount; ++s) {
+                combined.insert(combined.end(), values[s][v].begin(), values[s][v].end());
+                std::vector<float>().swap(values[s][v]);
+            }
+            if (valueQueries[v].metric == QuerySpec::PERCENTILE) {
+                results[valueIndex[v]] = Percentile::calculatePercentile(combined, valueQueries[v].percentile);
+            } else {
+                results[valueIndex[v]] = Percentile::calculateMedianAbsoluteDeviation(combined);
+            }
+        }
+    }
+
+    for (size_t p = 0; p < pending.size(); ++p) {
+        cache.store(queries[pending[p]].toKey(), generation, results[pending[p]]);
+    }
+    return results;
+}
+
+// Returns the sum of the generations of every station's data
+unsigned long long StationStore::getGeneration() const {
+    unsigned long long generation = 0;
+    for (size_t i = 0; i < stations.size(); ++i) {
+        generation += stations[i]->getCube().getGeneration();
+    }
+    return generation;
+}
+
+// Evaluates queries for every station separately, one task per station
+std::vector<std::vector<float> > StationStore::evaluateBatchPerStation(const std::vector<QuerySpec>& queries) const {
+    std::vector<std::vector<float> > results(stations.size());
+    forEachStation([&](int s) {
+        results[s] = stations[s]->getCalculator().evaluateBatch(queries);
+    });
+    return results;
+}
+
+// Evaluates a single query
+float StationStore::evaluate(const QuerySpec& query, int stationId) const {
+    return evaluateBatch(std::vector<QuerySpec>(1, query), stationId)[0];
+}
+
+// Evaluates a range query, merging the groups of every station
+std::vector<GroupResult> StationStore::evaluateRange(const RangeQuery& query, int stationId) const {
+    if (stationId != ALL_STATIONS) {
+        if (stationId < 0 || stationId >= getStationCount()) return std::vector<GroupResult>();
+        return stations[stationId]->getCalculator().evaluateRange(query);
+    }
+
+    std::vector<std::vector<GroupResult> > parts(stations.size());
+    forEachStation([&](int s) {
+        parts[s] = stations[s]->getCalculator().evaluateRange(query);
+    });
+
+    std::map<long long, GroupResult> groups;
+    for (size_t s = 0; s < parts.size(); ++s) {
+        for (size_t g = 0; g < parts[s].size(); ++g) {
+            const GroupResult& part = parts[s][g];
+            std::map<long long, GroupResult>::iterator it = groups.find(part.key);
+            if (it == groups.end()) {
+                groups.insert(std::make_pair(part.key, part));
+            } else {
+                it->second.summary.merge(part.summary);
+            }
+        }
+    }
+
+    std::vector<GroupResult> results;
+    for (std::map<long long, GroupResult>::const_iterator it = groups.begin(); it != groups.end(); ++it) {
+        results.push_back(it->second);
+    }
+    return results;
+}
+
+// Runs a task per station on the pool; a single station runs on the calling thread
+void StationStore::forEachStation(const std::function<void(int)>& task) const {
+    if (stations.size() == 1) {
+        task(0);
+        return;
+    }
+    std::vector<std::future<void> > pending;
+    for (size_t s = 0; s < stations.size(); ++s) {
+        int stationId = (int)s;
+        pending.push_back(pool.submit([&task, stationId]() { task(stationId); }));
+    }
+    for (size_t i = 0; i < pending.size(); ++i) {
+        pending[i].get();
+    }
+}
@@ -0,0 +1,144 @@
+#ifndef STATIONSTORE_H
+#define STATIONSTORE_H
+
+#include "Station.h"
+#include "QuerySpec.h"
+#include "RangeQuery.h"
+#include "ResultCache.h"
+#include "ThreadPool.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Weather data partitioned by station.
+ *
+ * Each station keeps its own records, summaries and calculator. Queries can be made for a
+ * single station or across all stations; in the latter case the station partitions are
+ * processed in parallel on a thread pool and their partial results (summaries, digests and
+ * deviation sums) are merged, so the combined results equal those of a single merged dataset.
+ * Combined results are cached until data is added to any station.
+ */
+class StationStore {
+public:
+    /**
+     * @brief Station identifier selecting all stations in queries.
+     */
+    static const int ALL_STATIONS = -1;
+
+    /**
+     * @brief Name of the station that receives data loaded without a station.
+     */
+    static const char* const DEFAULT_STATION;
+
+    /**
+     * @brief Constructs an empty store.
+     *
+     * @param threadCount The number of worker threads, or 0 to use one per hardware thread.
+     */
+    StationStore(size_t threadCount = 0);
+
+    /**
+     * @brief Returns the identifier of a station, adding the station if it does not exist.
+     *
+     * @param name The name of the station.
+     * @return The station identifier.
+     */
+    int addStation(const std::string& name);
+
+    /**
+     * @brief Returns the identifier of a station.
+     *
+     * @param name The name of the station.
+     * @return The station identifier, or -1 if there is no station with that name.
+     */
+    int findStation(const std::string& name) const;
+
+    /**
+     * @brief Returns the number of stations.
+     *
+     * @return The number of stations.
+     */
+    int getStationCount() const;
+
+    /**
+     * @brief Returns a station.
+     *
+     * @param stationId The identifier of the station.
+     * @return The station.
+     */
+    const Station& getStation(int stationId) const;
+
+    /**
+     * @brief Adds a record to a station.
+     *
+     * @param stationId The identifier of the station.
+     * @param record The record to add.
+     */
+    void add(int stationId, const WindTempSolar& record);
+
+    /**
+     * @brief Returns the number of records of all stations.
+     *
+     * @return The number of records.
+     */
+    long long getRecordCount() const;
+
+    /**
+     * @brief Returns the generation of the data of all stations, which changes whenever a record is added.
+     *
+     * @return The sum of the generations of every station.
+     */
+    unsigned long long getGeneration() const;
+
+    /**
+     * @brief Evaluates a list of queries for one station or across all stations.
+     *
+     * @param queries The queries to evaluate.
+     * @param stationId The station to query, or ALL_STATIONS.
+     * @return The results, in the same order as the queries.
+     */
+    std::vector<float> evaluateBatch(const std::vector<QuerySpec>& queries, int stationId = ALL_STATIONS) const;
+
+    /**
+     * @brief Evaluates a list of queries for every station separately, in parallel.
+     *
+     * @param queries The queries to evaluate.
+     * @return The results of each station, indexed by station identifier.
+     */
+    std::vector<std::vector<float> > evaluateBatchPerStation(const std::vector<QuerySpec>& queries) const;
+
+    /**
+     * @brief Evaluates a single query for one station or across all stations.
+     *
+     * @param query The query to evaluate.
+     * @param stationId The station to query, or ALL_STATIONS.
+     * @return The result of the query.
+     */
+    float evaluate(const QuerySpec& query, int stationId = ALL_STATIONS) const;
+
+    /**
+     * @brief Evaluates a range query for one station or across all stations.
+     *
+     * @param query The time range and grouping.
+     * @param stationId The station to query, or ALL_STATIONS.
+     * @return The summaries of the groups that contain data, in chronological order.
+     */
+    std::vector<GroupResult> evaluateRange(const RangeQuery& query, int stationId = ALL_STATIONS) const;
+
+private:
+    StationStore(const StationStore&);
+    StationStore& operator=(const StationStore&);
+
+    /**
+     * @brief Runs a task for every station on the thread pool and waits for all of them.
+     * @param task The task, called with the station identifier.
+     */
+    void forEachStation(const std::function<void(int)>& task) const;
+
+    std::vector<std::unique_ptr<Station> > stations;   /**< The stations, indexed by identifier. */
+    mutable ThreadPool pool;                            /**< Workers processing station partitions. */
+    mutable ResultCache cache;                          /**< Combined results across stations, keyed by query. */
+};
+
+#endif // STATIONSTORE_H
@@ -0,0 +1,235 @@
+#include "SummaryCube.h"
+#include <iterator>
+
+const float SummaryCube::WIND_BIN_WIDTH = 0.5f;
+const int SummaryCube::WIND_BIN_COUNT = 100;
+
+// Constructor creates an empty cube with a fixed or inferred sampling interval
+SummaryCube::SummaryCube(long long sampleMinutes)
+    : recordCount(0), configuredMinutes(sampleMinutes > 0 ? sampleMinutes : 0), commonStep(0),
+      sampleMinutes(configuredMinutes), generation(0) {}
+
+// Adds a record to the summary of its (year, month) and of its month across all years
+void SummaryCube::add(const WindTempSolar& record) {
+    Date date = record.getDate();
+    int key = makeKey(date.getMonth(), date.getYear());
+    bool inYear = date.getMonth() >= 1 && date.getMonth() <= 12;
+    checkTimestamp(record.getTimestamp(), key);
+    summaries[key].add(record);
+    std::vector<TDigest>& monthDigests = digests[key];
+    if (monthDigests.empty()) {
+        monthDigests.resize(WindTempSolar::FIELD_COUNT);
+    }
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+        monthDigests[f].add(record.getValue(f));
+    }
+    std::map<int, Histogram>::iterator histogram = windHistograms.find(key);
+    if (histogram == windHistograms.end()) {
+        histogram = windHistograms.insert(std::make_pair(key, Histogram(WIND_BIN_WIDTH, WIND_BIN_COUNT))).first;
+    }
+    histogram->second.add(record.getWindSpeed());
+    if (inYear) {
+        monthSummaries[date.getMonth() - 1].add(record);
+    }
+    recordCount++;
+    generation++;
+}
+
+// Returns the sampling interval used to count gaps
+long long SummaryCube::getSampleMinutes() const {
+    return sampleMinutes;
+}
+
+// Returns the summary for the specified month and year
+const MonthlySummary& SummaryCube::getSummary(int month, int year) const {
+    std::map<int, MonthlySummary>::const_iterator it = summaries.find(makeKey(month, year));
+    return (it != summaries.end()) ? it->second : emptySummary;
+}
+
+// Returns the summary for the specified month across all years
+const MonthlySummary& SummaryCube::getMonthSummary(int month) const {
+    if (month < 1 || month > 12) return emptySummary;
+    return monthSummaries[month - 1];
+}
+
+// Merges the summaries of all months between (month, year) and (endMonth, endYear)
+MonthlySummary SummaryCube::getRangeSummary(int month, int year, int endMonth, int endYear) const {
+    MonthlySummary result;
+    if (makeKey(month, year) > makeKey(endMonth, endYear)) return result;
+    std::map<int, MonthlySummary>::const_iterator it = summaries.lower_bound(makeKey(month, year));
+    std::map<int, MonthlySummary>::const_iterator end = summaries.upper_bound(makeKey(endMonth, endYear));
+    for (; it != end; ++it) {
+        result.merge(it->second);
+    }
+    return result;
+}
+
+// Returns the summaries of all months with data between (month, year) and (endMonth, endYear)
+std::vector<std::pair<Date, const MonthlySummary*> > SummaryCube::getSummaries(int month, int year, int endMonth, int endYear) const {
+    std::vector<std::pair<Date, const MonthlySummary*> > result;
+    if (makeKey(month, year) > makeKey(endMonth, endYear)) return result;
+    std::map<int, MonthlySummary>::const_iterator it = summaries.lower_bound(makeKey(month, year));
+    std::map<int, MonthlySummary>::const_iterator end = summaries.upper_bound(makeKey(endMonth, endYear));
+    for (; it != end; ++it) {
+        result.push_back(std::make_pair(Date(1, it->first % 100, it->first / 100), &it->second));
+    }
+    return result;
+}
+
+// Returns the digest of a field for one month, or for the month across all years
+TDigest SummaryCube::getDigest(const std::string& field, int month, int year) const {
+    TDigest result;
+    int f = WindTempSolar::getFieldIndex(field);
+    if (f < 0) return result;
+    std::map<int, std::vector<TDigest> >::const_iterator it;
+    if (year != 0) {
+        it = digests.find(makeKey(month, year));
+        return (it != digests.end()) ? it->second[f] : result;
+    }
+    for (it = digests.begin(); it != digests.end(); ++it) {
+        if (it->first % 100 == month) {
+            result.merge(it->second[f]);
+        }
+    }
+    return result;
+}
+
+// Merges the digests of a field for all months between (month, year) and (endMonth, endYear)
+TDigest SummaryCube::getRangeDigest(const std::string& field, int month, int year, int endMonth, int endYear) const {
+    TDigest result;
+    int f = WindTempSolar::getFieldIndex(field);
+    if (f < 0 || makeKey(month, year) > makeKey(endMonth, endYear)) return result;
+    std::map<int, std::vector<TDigest> >::const_iterator it = digests.lower_bound(makeKey(month, year));
+    std::map<int, std::vector<TDigest> >::const_iterator end = digests.upper_bound(makeKey(endMonth, endYear));
+    for (; it != end; ++it) {
+        result.merge(it->second[f]);
+    }
+    return result;
+}
+
+// Returns the wind speed histogram for one month, or for the month across all years
+Histogram SummaryCube::getWindSpeedHistogram(int month, int year) const {
+    Histogram result(WIND_BIN_WIDTH, WIND_BIN_COUNT);
+    std::map<int, Histogram>::const_iterator it;
+    if (year != 0) {
+        it = windHistograms.find(makeKey(month, year));
+        return (it != windHistograms.end()) ? it->second : result;
+    }
+    for (it = windHistograms.begin(); it != windHistograms.end(); ++it) {
+        if (it->first % 100 == month) {
+            result.merge(it->second);
+        }
+    }
+    return result;
+}
+
+// Returns the number of records added to the cube
+long long SummaryCube::getRecordCount() const {
+    return recordCount;
+}
+
+// Returns the dataset generation
+unsigned long long SummaryCube::getGeneration() const {
+    return generation;
+}
+
+// Builds the key used to look up a (year, month) summary
+int SummaryCube::makeKey(int month, int year) {
+    return year * 100 + month;
+}
+
+// Returns the summary of a key's month across all years
+MonthlySummary* SummaryCube::findMonthSummary(int key) {
+    int month = key % 100;
+    return (month >= 1 && month <= 12) ? &monthSummaries[month - 1] : nullptr;
+}
+
+// Looks a timestamp up in the index, counting a duplicate or replacing the step it splits
+void SummaryCube::checkTimestamp(long long timestamp, int key) {
+    std::map<long long, int>::iterator next = timestamps.lower_bound(timestamp);
+    if (next != timestamps.end() && next->first == timestamp) {
+        summaries[key].addDuplicate();
+        MonthlySummary* monthSummary = findMonthSummary(key);
+        if (monthSummary) monthSummary->addDuplicate();
+        return;
+    }
+
+    // Records in time order are appended, so the hint keeps ingest from searching the index again
+    std::map<long long, int>::iterator inserted = timestamps.insert(next, std::make_pair(timestamp, key));
+    if (inserted != timestamps.begin()) {
+        std::map<long long, int>::iterator previous = std::prev(inserted);
+        if (next != timestamps.end()) countStep(next->first - previous->first, next->second, -1);
+        countStep(timestamp - previous->first, key, 1);
+    }
+    if (next != timestamps.end()) countStep(next->first - timestamp, next->second, 1);
+
+    if (configuredMinutes == 0 && commonStep != sampleMinutes) {
+        sampleMinutes = commonStep;
+        recountGaps();
+    }
+}
+
+// Adds or takes back a step, with its gap under the current interval, and keeps the most common step
+void SummaryCube::countStep(long long step, int key, long long delta) {
+    std::map<long long, long long>& steps = monthSteps[key];
+    if ((steps[step] += delta) == 0) steps.erase(step);
+    long long total = (stepCounts[step] += delta);
+    if (total == 0) stepCounts.erase(step);
+
+    if (sampleMinutes > 0 && step > sampleMinutes) {
+        long long missing = (step - 1) / sampleMinutes;
+        MonthlySummary* monthSummary = findMonthSummary(key);
+        if (delta > 0) {
+            summaries[key].addGap(missing);
+            if (monthSummary) monthSummary->addGap(missing);
+        } else {
+            summaries[key].removeGap(missing);
+            if (monthSummary) monthSummary->removeGap(missing);
+        }
+    }
+
+    if (configuredMinutes != 0) return;
+    if (delta > 0) {
+        std::map<long long, long long>::const_iterator common = stepCounts.find(commonStep);
+        long long commonCount = (common != stepCounts.end()) ? common->second : 0;
+        if (total > commonCount || (total == commonCount && step < commonStep)) commonStep = step;
+    } else if (step == commonStep) {
+        commonStep = findMostCommonStep();
+    }
+}
+
+// Returns the most common step, the smallest on a tie
+long long SummaryCube::findMostCommonStep() const {
+    long long best = 0;
+    long long bestCount = 0;
+    for (std::map<long long, long long>::const_iterator it = stepCounts.begin(); it != stepCounts.end(); ++it) {
+        if (it->second > bestCount) {
+            best = it->first;
+            bestCount = it->second;
+        }
+    }
+    return best;
+}
+
+// Counts every gap again with the current interval
+void SummaryCube::recountGaps() {
+    for (std::map<int, MonthlySummary>::iterator it = summaries.begin(); it != summaries.end(); ++it) {
+        it->second.clearGaps();
+    }
+    for (int m = 0; m < 12; ++m) {
+        monthSummaries[m].clearGaps();
+    }
+    if (sampleMinutes <= 0) return;
+    for (std::map<int, std::map<long long, long long> >::const_iterator month = monthSteps.begin(); month != monthSteps.end(); ++month) {
+        MonthlySummary& summary = summaries[month->first];
+        MonthlySummary* monthSummary = findMonthSummary(month->first);
+        // Steps are ordered, so the gaps are the steps after the interval
+        for (std::map<long long, long long>::const_iterator step = month->second.upper_bound(sampleMinutes); step != month->second.end(); ++step) {
+            long long missing = (step->first - 1) / sampleMinutes;
+            for (long long i = 0; i < step->second; ++i) {
+                summary.addGap(missing);
+                if (monthSummary) monthSummary->addGap(missing);
+            }
+        }
+    }
+}
@@ -0,0 +1,196 @@
+#ifndef SUMMARYCUBE_H
+#define SUMMARYCUBE_H
+
+#include "MonthlySummary.h"
+#include "TDigest.h"
+#include "Histogram.h"
+#include "WindTempSolar.h"
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Cube of per-(year, month) summaries maintained while data is ingested.
+ *
+ * Every record added to the cube updates the summary of its (year, month) and the
+ * summary of its month across all years, so per-month aggregates can be answered
+ * without rescanning the raw records. A t-digest of each field is kept per (year, month)
+ * for approximate percentiles, along with a fixed-width histogram of wind speed.
+ *
+ * The cube also checks the timestamps as records arrive. It keeps an index of the distinct
+ * timestamps, so a record whose timestamp is already indexed is counted as a duplicate in the
+ * summaries of its month, whichever file it came from. A step between neighbouring timestamps
+ * longer than the sampling interval is counted as a gap in the month of the later timestamp.
+ * The interval is fixed for the cube when configured, and otherwise the most common step; the
+ * gaps are counted again if the most common step changes. Records may arrive in any order: a
+ * record falling inside a gap splits it.
+ */
+class SummaryCube {
+public:
+    static const float WIND_BIN_WIDTH; /**< Width of the wind speed histogram bins. */
+    static const int WIND_BIN_COUNT;   /**< Number of wind speed histogram bins. */
+
+    /**
+     * @brief Constructs an empty cube.
+     *
+     * @param sampleMinutes The sampling interval of the data in minutes, or 0 to use the most common step.
+     */
+    explicit SummaryCube(long long sampleMinutes = 0);
+
+    /**
+     * @brief Adds a record to the summaries of its month.
+     *
+     * @param record The record to add.
+     */
+    void add(const WindTempSolar& record);
+
+    /**
+     * @brief Returns the sampling interval used to count gaps.
+     *
+     * @return The configured interval, or the most common step between timestamps in minutes, 0 if not known yet.
+     */
+    long long getSampleMinutes() const;
+
+    /**
+     * @brief Returns the summary for the specified month and year.
+     *
+     * @param month The month (1-12).
+     * @param year The year.
+     * @return The summary, or an empty summary if no records fall in that month.
+     */
+    const MonthlySummary& getSummary(int month, int year) const;
+
+    /**
+     * @brief Returns the summary for the specified month across all years.
+     *
+     * @param month The month (1-12).
+     * @return The summary, or an empty summary if the month is out of range.
+     */
+    const MonthlySummary& getMonthSummary(int month) const;
+
+    /**
+     * @brief Returns the merged summary of an inclusive range of months.
+     *
+     * @param month The first month of the range.
+     * @param year The year of the first month.
+     * @param endMonth The last month of the range.
+     * @param endYear The year of the last month.
+     * @return The summary of all records in the range.
+     */
+    MonthlySummary getRangeSummary(int month, int year, int endMonth, int endYear) const;
+
+    /**
+     * @brief Returns the summaries of all months with data in an inclusive range of months.
+     *
+     * @param month The first month of the range.
+     * @param year The year of the first month.
+     * @param endMonth The last month of the range.
+     * @param endYear The year of the last month.
+     * @return Pairs of the first day of each month and its summary, in chronological order.
+     */
+    std::vector<std::pair<Date, const MonthlySummary*> > getSummaries(int month, int year, int endMonth, int endYear) const;
+
+    /**
+     * @brief Returns the percentile digest of a field for the specified month and year.
+     *
+     * @param field The name of the field (e.g., "wind_speed").
+     * @param month The month (1-12).
+     * @param year The year, or 0 to merge the month across all years.
+     * @return The digest, empty if there is no data or the field is unknown.
+     */
+    TDigest getDigest(const std::string& field, int month, int year) const;
+
+    /**
+     * @brief Returns the merged percentile digest of a field over an inclusive range of months.
+     *
+     * @param field The name of the field.
+     * @param month The first month of the range.
+     * @param year The year of the first month.
+     * @param endMonth The last month of the range.
+     * @param endYear The year of the last month.
+     * @return The merged digest.
+     */
+    TDigest getRangeDigest(const std::string& field, int month, int year, int endMonth, int endYear) const;
+
+    /**
+     * @brief Returns the wind speed histogram for the specified month and year.
+     *
+     * @param month The month (1-12).
+     * @param year The year, or 0 to merge the month across all years.
+     * @return The histogram, empty if there is no data.
+     */
+    Histogram getWindSpeedHistogram(int month, int year) const;
+
+    /**
+     * @brief Returns the number of records added to the cube.
+     *
+     * @return The number of records.
+     */
+    long long getRecordCount() const;
+
+    /**
+     * @brief Returns the dataset generation.
+     *
+     * The generation changes whenever data is added, so cached results can detect that they are stale.
+     *
+     * @return The current generation.
+     */
+    unsigned long long getGeneration() const;
+
+private:
+    /**
+     * @brief Builds the map key for a month and year.
+     */
+    static int makeKey(int month, int year);
+
+    /**
+     * @brief Returns the summary of a key's month across all years.
+     *
+     * @return The summary, or null if the key's month is out of range.
+     */
+    MonthlySummary* findMonthSummary(int key);
+
+    /**
+     * @brief Adds a timestamp to the index, counting it as a duplicate or updating the gaps around it.
+     *
+     * @param timestamp The timestamp of the new record.
+     * @param key The key of the record's (year, month).
+     */
+    void checkTimestamp(long long timestamp, int key);
+
+    /**
+     * @brief Adds or takes back a step between neighbouring timestamps, with the gap it makes.
+     *
+     * @param step The step in minutes.
+     * @param key The key of the (year, month) of the later timestamp.
+     * @param delta 1 to add the step, -1 to take it back.
+     */
+    void countStep(long long step, int key, long long delta);
+
+    /**
+     * @brief Returns the most common step between neighbouring timestamps, the smallest on a tie.
+     */
+    long long findMostCommonStep() const;
+
+    /**
+     * @brief Counts the gaps of every summary again from the steps, after the interval changed.
+     */
+    void recountGaps();
+
+    std::map<int, MonthlySummary> summaries; /**< Summaries keyed by year and month. */
+    std::map<int, std::vector<TDigest> > digests; /**< Percentile digests of each field keyed by year and month. */
+    std::map<int, Histogram> windHistograms; /**< Wind speed histograms keyed by year and month. */
+    MonthlySummary monthSummaries[12];       /**< Summaries of each month across all years. */
+    MonthlySummary emptySummary;             /**< Returned for periods without data. */
+    long long recordCount;                   /**< Number of records added. */
+    std::map<long long, int> timestamps;     /**< Key of the (year, month) of each distinct timestamp. */
+    std::map<int, std::map<long long, long long> > monthSteps; /**< Number of each step, keyed by the (year, month) of the later timestamp. */
+    std::map<long long, long long> stepCounts; /**< Number of each step between neighbouring timestamps. */
+    long long configuredMinutes;             /**< Configured sampling interval, 0 to use the most common step. */
+    long long commonStep;                    /**< Most common step, 0 until known. */
+    long long sampleMinutes;                 /**< Interval the gaps are counted with, 0 until known. */
+    unsigned long long generation;           /**< Incremented on every change to the data. */
+};
+
+#endif // SUMMARYCUBE_H
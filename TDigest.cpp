@@ -0,0 +1,135 @@
+#include "TDigest.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const double PI = 3.14159265358979323846;
+
+// Orders centroids by their mean
+struct CentroidLess {
+    template <class C>
+    bool operator()(const C& a, const C& b) const { return a.mean < b.mean; }
+};
+}
+
+// Constructor creates an empty digest
+TDigest::TDigest(double compression) : compression(compression), count(0), min(0), max(0) {}
+
+// Buffers a value, merging the buffer into the centroids when it is full
+void TDigest::add(float value) {
+    if (std::isnan(value)) return;
+    if (count == 0 || value < min) min = value;
+    if (count == 0 || value > max) max = value;
+    count++;
+    buffer.push_back(value);
+    if (buffer.size() >= (size_t)(5 * compression)) {
+        compress();
+    }
+}
+
+// Merges another digest by adding its centroids and re-compressing
+void TDigest::merge(const TDigest& other) {
+    if (other.count == 0) return;
+    if (count == 0 || other.min < min) min = other.min;
+    if (count == 0 || other.max > max) max = other.max;
+    count += other.count;
+    centroids.insert(centroids.end(), other.centroids.begin(), other.centroids.end());
+    buffer.insert(buffer.end(), other.buffer.begin(), other.buffer.end());
+    compress();
+}
+
+// Estimates a percentile by interpolating between centroid centres
+float TDigest::getPercentile(float percentile) const {
+    if (count == 0) return 0;
+    if (!buffer.empty()) {
+        // Work on a compressed copy so the digest itself stays unchanged
+        TDigest copy(*this);
+        copy.compress();
+        return copy.getPercentile(percentile);
+    }
+    if (percentile <= 0) return min;
+    if (percentile >= 100) return max;
+    if (centroids.size() == 1) return (float)centroids[0].mean;
+
+    double total = (double)count;
+    double index = percentile / 100.0 * total;
+
+    // Between the minimum and the centre of the first centroid
+    const Centroid& first = centroids.front();
+    if (index < first.weight / 2) {
+        return (float)(min + (index / (first.weight / 2)) * (first.mean - min));
+    }
+
+    // Between the centres of two adjacent centroids
+    double weightSoFar = first.weight / 2;
+    for (size_t i = 0; i + 1 < centroids.size(); ++i) {
+        double gap = (centroids[i].weight + centroids[i + 1].weight) / 2;
+        if (weightSoFar + gap > index) {
+            double fraction = (index - weightSoFar) / gap;
+            return (float)(centroids[i].mean + fraction * (centroids[i + 1].mean - centroids[i].mean));
+        }
+        weightSoFar += gap;
+    }
+
+    // Between the centre of the last centroid and the maximum
+    const Centroid& last = centroids.back();
+    double fraction = (index - weightSoFar) / (last.weight / 2);
+    if (fraction > 1) fraction = 1;
+    return (float)(last.mean + fraction * (max - last.mean));
+}
+
+// Returns the number of values added to the digest
+long long TDigest::getCount() const {
+    return count;
+}
+
+// Returns the number of centroids, counting buffered values as single centroids
+size_t TDigest::getCentroidCount() const {
+    return centroids.size() + buffer.size();
+}
+
+// Merges the buffered values into the centroids, keeping each centroid within its size limit
+void TDigest::compress() {
+    std::vector<Centroid> all(centroids);
+    all.reserve(centroids.size() + buffer.size());
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        Centroid c = { buffer[i], 1 };
+        all.push_back(c);
+    }
+    buffer.clear();
+    centroids.clear();
+    if (all.empty()) return;
+    std::sort(all.begin(), all.end(), CentroidLess());
+
+    double total = 0;
+    for (size_t i = 0; i < all.size(); ++i) total += all[i].weight;
+
+    double weightSoFar = 0;
+    double weightLimit = total * inverseScale(scale(0) + 1);
+    Centroid current = all[0];
+    for (size_t i = 1; i < all.size(); ++i) {
+        if (weightSoFar + current.weight + all[i].weight <= weightLimit) {
+            // Absorb the next centroid into the current one
+            current.weight += all[i].weight;
+            current.mean += (all[i].mean - current.mean) * all[i].weight / current.weight;
+        } else {
+            weightSoFar += current.weight;
+            centroids.push_back(current);
+            weightLimit = total * inverseScale(scale(weightSoFar / total) + 1);
+            current = all[i];
+        }
+    }
+    centroids.push_back(current);
+}
+
+// Scale function k1: small centroids at the tails, large ones around the median
+double TDigest::scale(double q) const {
+    return compression / (2 * PI) * std::asin(2 * q - 1);
+}
+
+// Inverse of the scale function, clamped to the quantile range
+double TDigest::inverseScale(double k) const {
+    double angle = k * 2 * PI / compression;
+    if (angle >= PI / 2) return 1;
+    return (std::sin(angle) + 1) / 2;
+}
@@ -0,0 +1,93 @@
+#ifndef TDIGEST_H
+#define TDIGEST_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Bounded-memory streaming sketch for approximate percentiles (merging t-digest).
+ *
+ * Values are buffered and periodically merged into a small set of weighted centroids.
+ * Centroids near the tails are kept small, so extreme percentiles such as P99 stay
+ * accurate. Two digests can be merged, so per-month digests can be combined into
+ * digests of longer periods.
+ */
+class TDigest {
+public:
+    /**
+     * @brief Constructs an empty digest.
+     *
+     * @param compression Controls the number of centroids (about compression / 2 after merging);
+     *        higher values are more accurate and use more memory.
+     */
+    TDigest(double compression = 200);
+
+    /**
+     * @brief Adds a value to the digest.
+     *
+     * NaN values are ignored.
+     *
+     * @param value The value to add.
+     */
+    void add(float value);
+
+    /**
+     * @brief Merges another digest into this one.
+     *
+     * @param other The digest to merge.
+     */
+    void merge(const TDigest& other);
+
+    /**
+     * @brief Estimates a percentile.
+     *
+     * @param percentile The percentile to estimate (0-100).
+     * @return The estimated percentile, or 0 if the digest is empty.
+     */
+    float getPercentile(float percentile) const;
+
+    /**
+     * @brief Returns the number of values added to the digest.
+     *
+     * @return The number of values.
+     */
+    long long getCount() const;
+
+    /**
+     * @brief Returns the number of centroids, including buffered values not yet merged.
+     *
+     * @return The number of centroids.
+     */
+    size_t getCentroidCount() const;
+
+private:
+    // Centroid represents a group of nearby values by their mean and count
+    struct Centroid {
+        double mean;    ///< Mean of the values in the centroid
+        double weight;  ///< Number of values in the centroid
+    };
+
+    /**
+     * @brief Merges the buffered values into the centroids.
+     */
+    void compress();
+
+    /**
+     * @brief Scale function mapping a quantile to the centroid index space.
+     */
+    double scale(double q) const;
+
+    /**
+     * @brief Inverse of the scale function.
+     */
+    double inverseScale(double k) const;
+
+    double compression;              /**< Compression parameter. */
+    std::vector<Centroid> centroids; /**< Merged centroids, sorted by mean. */
+    std::vector<float> buffer;       /**< Values not yet merged into centroids. */
+    long long count;                 /**< Number of values added. */
+    float min;                       /**< Smallest value added. */
+    float max;                       /**< Largest value added. */
+};
+
+#endif // TDIGEST_H
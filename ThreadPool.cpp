@@ -0,0 +1,54 @@
+#include "ThreadPool.h"
+
+// Constructor starts the worker threads
+ThreadPool::ThreadPool(size_t threadCount) : stopping(false) {
+    if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.push_back(std::thread(&ThreadPool::work, this));
+    }
+}
+
+// Destructor lets the workers drain the queue and joins them
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+}
+
+// Queues a task and returns a future for its completion
+std::future<void> ThreadPool::submit(const std::function<void()>& task) {
+    std::packaged_task<void()> packaged(task);
+    std::future<void> result = packaged.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(packaged));
+    }
+    available.notify_one();
+    return result;
+}
+
+// Returns the number of worker threads
+size_t ThreadPool::getThreadCount() const {
+    return workers.size();
+}
+
+// Worker loop: takes tasks from the queue until the pool stops and the queue is empty
+void ThreadPool::work() {
+    for (;;) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed-size pool of worker threads running submitted tasks.
+ *
+ * Each submitted task returns a future, so callers wait only for their own tasks and
+ * several callers can share the pool. Exceptions thrown by a task are rethrown by the
+ * future's get().
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Starts the worker threads.
+     *
+     * @param threadCount The number of workers, or 0 to use one per hardware thread.
+     */
+    ThreadPool(size_t threadCount = 0);
+
+    /**
+     * @brief Finishes the queued tasks and stops the worker threads.
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Queues a task for execution by a worker.
+     *
+     * @param task The task to run.
+     * @return A future that becomes ready when the task has finished.
+     */
+    std::future<void> submit(const std::function<void()>& task);
+
+    /**
+     * @brief Returns the number of worker threads.
+     *
+     * @return The number of workers.
+     */
+    size_t getThreadCount() const;
+
+private:
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+    /**
+     * @brief Runs queued tasks until the pool is stopped.
+     */
+    void work();
+
+    std::vector<std::thread> workers;                   /**< The worker threads. */
+    std::queue<std::packaged_task<void()> > tasks;      /**< Tasks waiting for a worker. */
+    std::mutex mutex;                                   /**< Guards the task queue and the stop flag. */
+    std::condition_variable available;                  /**< Signalled when a task is queued or the pool stops. */
+    bool stopping;                                      /**< Set when the pool is being destroyed. */
+};
+
+#endif // THREADPOOL_H
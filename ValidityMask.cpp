@@ -0,0 +1,61 @@
+#include "ValidityMask.h"
+
+// Constructor creates an empty mask
+ValidityMask::ValidityMask() : count(0), invalidCount(0) {}
+
+// Appends one bit, starting a new word every 64 values
+void ValidityMask::append(bool valid) {
+    if (count % WORD_BITS == 0) words.push_back(0);
+    words.back() |= (uint64_t)valid << (count % WORD_BITS);
+    invalidCount += valid ? 0 : 1;
+    count++;
+}
+
+// Returns the number of values covered
+size_t ValidityMask::size() const {
+    return count;
+}
+
+// Checks the bit of a value
+bool ValidityMask::isValid(size_t index) const {
+    return (words[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+}
+
+// Returns the number of words
+size_t ValidityMask::getWordCount() const {
+    return words.size();
+}
+
+// Returns a word of the bitmap
+uint64_t ValidityMask::getWord(size_t word) const {
+    return words[word];
+}
+
+// Returns the number of invalid values
+size_t ValidityMask::getInvalidCount() const {
+    return invalidCount;
+}
+
+// Returns the memory used by the words
+size_t ValidityMask::getMemoryBytes() const {
+    return words.capacity() * sizeof(uint64_t);
+}
+
+// Counts set bits by adding them in parallel within the word
+int ValidityMask::countBits(uint64_t word) {
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (int)((word * 0x0101010101010101ull) >> 56);
+}
+
+// Finds the lowest set bit with a de Bruijn multiplication, which needs no compiler intrinsics
+int ValidityMask::lowestBit(uint64_t word) {
+    static const int positions[64] = {
+        0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+        62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+        63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+        46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6
+    };
+    return positions[((word & (~word + 1)) * 0x03F79D71B4CB0A89ull) >> 58];
+}
@@ -0,0 +1,106 @@
+#ifndef VALIDITYMASK_H
+#define VALIDITYMASK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Compact bitmap marking which values of a channel are valid.
+ *
+ * Bit i of word i / 64 is set when value i is valid (not NaN). Kernels combine a word of the
+ * bitmap with a filter mask of the same 64 records using bitwise operations, and reduce the
+ * selected values without a branch per record; words with no invalid values can take a plain
+ * unmasked path, so clean data is not slowed down.
+ */
+class ValidityMask {
+public:
+    /**
+     * @brief Number of values per word.
+     */
+    static const int WORD_BITS = 64;
+
+    /**
+     * @brief Constructs an empty mask.
+     */
+    ValidityMask();
+
+    /**
+     * @brief Appends the validity of the next value.
+     *
+     * @param valid Whether the value is valid.
+     */
+    void append(bool valid);
+
+    /**
+     * @brief Returns the number of values covered.
+     *
+     * @return The number of values.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Checks whether a value is valid.
+     *
+     * @param index The index of the value.
+     * @return true if the value is valid.
+     */
+    bool isValid(size_t index) const;
+
+    /**
+     * @brief Returns the number of words.
+     *
+     * @return The number of 64-bit words.
+     */
+    size_t getWordCount() const;
+
+    /**
+     * @brief Returns a word of the bitmap.
+     *
+     * Bits past the last value of the final word are zero.
+     *
+     * @param word The index of the word.
+     * @return The word.
+     */
+    uint64_t getWord(size_t word) const;
+
+    /**
+     * @brief Returns the number of invalid values.
+     *
+     * @return The number of values whose bit is clear.
+     */
+    size_t getInvalidCount() const;
+
+    /**
+     * @brief Returns the memory used by the bitmap.
+     *
+     * @return The number of bytes.
+     */
+    size_t getMemoryBytes() const;
+
+    /**
+     * @brief Counts the set bits of a word.
+     *
+     * @param word The word.
+     * @return The number of set bits.
+     */
+    static int countBits(uint64_t word);
+
+    /**
+     * @brief Returns the index of the lowest set bit of a word.
+     *
+     * Kernels that gather the selected values visit the set bits of a mask with this, clearing
+     * each one with word &= word - 1, instead of testing every bit.
+     *
+     * @param word The word, which must not be zero.
+     * @return The index of the lowest set bit (0-63).
+     */
+    static int lowestBit(uint64_t word);
+
+private:
+    std::vector<uint64_t> words;    /**< The bits, 64 values per word. */
+    size_t count;                   /**< Number of values covered. */
+    size_t invalidCount;            /**< Number of invalid values. */
+};
+
+#endif // VALIDITYMASK_H
@@ -0,0 +1,183 @@
+#include "WeatherDataset.h"
+#include "IngestPipeline.h"
+#include <fstream>
+#include <mutex>
+
+// Constructor creates an empty dataset
+WeatherDataset::WeatherDataset(size_t threadCount) : stations(threadCount), malformedCount(0) {
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+        invalidCounts[f] = 0;
+    }
+}
+
+// Reads the file names of a source list, grouped by station, and loads them
+bool WeatherDataset::loadSourceList(const std::string& filename, std::string& error) {
+    std::ifstream sourceFile(filename.c_str());
+    if (!sourceFile.is_open()) {
+        error = "Unable to open " + filename;
+        return false;
+    }
+    // File names are relative to the directory of the list
+    size_t slash = filename.find_last_of('/');
+    std::string directory = (slash == std::string::npos) ? "" : filename.substr(0, slash + 1);
+    std::string stationName = StationStore::DEFAULT_STATION;
+    std::string line;
+    while (std::getline(sourceFile, line)) {
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+            line.erase(line.size() - 1);
+        }
+        if (line.size() > 2 && line[0] == '[' && line[line.size() - 1] == ']') {
+            stationName = line.substr(1, line.size() - 2);
+        } else if (!line.empty()) {
+            addFile(directory + line, stationName);
+        }
+    }
+    load();
+    return true;
+}
+
+// Queues a file for the next load
+void WeatherDataset::addFile(const std::string& filename, const std::string& station) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    pending.push_back(std::make_pair(filename, station));
+}
+
+// Loads the queued files through the ingest pipeline, with queries held off until it finishes
+void WeatherDataset::load() {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (pending.empty()) return;
+    IngestPipeline pipeline;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        pipeline.addFile(pending[i].first, stations.addStation(pending[i].second));
+    }
+    pending.clear();
+    pipeline.run(stations);
+    errors.insert(errors.end(), pipeline.getErrors().begin(), pipeline.getErrors().end());
+    malformedCount += pipeline.getMalformedCount();
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+        invalidCounts[f] += pipeline.getInvalidCount(f);
+    }
+}
+
+// Adds a record to a station, creating the station if needed
+void WeatherDataset::add(const std::string& station, const WindTempSolar& record) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    stations.add(stations.addStation(station), record);
+}
+
+// Builds the lazily built indexes of every station; the stores guard index building themselves
+void WeatherDataset::buildIndexes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    for (int s = 0; s < stations.getStationCount(); ++s) {
+        const RecordStore& store = stations.getStation(s).getStore();
+        store.getOrderedIndex();
+        store.getTimestampIndex();
+    }
+}
+
+// Returns the messages of files that could not be read
+std::vector<std::string> WeatherDataset::getErrors() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return errors;
+}
+
+// Returns the number of malformed rows skipped
+long long WeatherDataset::getMalformedCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return malformedCount;
+}
+
+// Returns the number of invalid values of a field
+long long WeatherDataset::getInvalidCount(int fieldIndex) const {
+    if (fieldIndex < 0 || fieldIndex >= WindTempSolar::FIELD_COUNT) return 0;
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return invalidCounts[fieldIndex];
+}
+
+// Returns the number of records of all stations
+long long WeatherDataset::getRecordCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return stations.getRecordCount();
+}
+
+// Returns the identifier of a station
+int WeatherDataset::findStation(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return stations.findStation(name);
+}
+
+// Evaluates a single query
+float WeatherDataset::evaluate(const QuerySpec& query, int stationId) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return stations.evaluate(query, stationId);
+}
+
+// Evaluates a list of queries as one batch
+std::vector<float> WeatherDataset::evaluateBatch(const std::vector<QuerySpec>& queries, int stationId) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return stations.evaluateBatch(queries, stationId);
+}
+
+// Evaluates a range query
+std::vector<GroupResult> WeatherDataset::evaluateRange(const RangeQuery& query, int stationId) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return stations.evaluateRange(query, stationId);
+}
+
+// Evaluates a batch report and writes it, labelled with the station name
+void WeatherDataset::writeReport(const BatchReport& reports, ReportWriter& writer, int stationId) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::vector<float> results = stations.evaluateBatch(reports.getQueries(), stationId);
+    std::string stationLabel = (stationId == StationStore::ALL_STATIONS) ? "all" : stations.getStation(stationId).getName();
+    reports.write(writer, results, stationLabel);
+}
+
+// Writes the monthly report of a year with two decimals
+void WeatherDataset::writeMonthlyReport(int year, ReportWriter& writer) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    writer.writeText("Month, Average Wind Speed (km/h) (stdev, mad), Average Ambient Air Temperature (\xB0" "C) (stdev, mad), Total Solar Radiation (kWh/m^2)\n");
+
+    // Every statistic of every month goes through one batch, so queries for the same month share a scan.
+    // The temperature stdev column has always reported the wind speed deviation; it is kept so reports stay comparable.
+    const int COLUMNS = 7;
+    std::vector<QuerySpec> queries;
+    queries.reserve(12 * COLUMNS);
+    for (int month = 1; month <= 12; ++month) {
+        queries.push_back(QuerySpec(QuerySpec::MEAN, "wind_speed", month, year));
+        queries.push_back(QuerySpec(QuerySpec::STANDARD_DEVIATION, "wind_speed", month, year));
+        queries.push_back(QuerySpec(QuerySpec::MEAN_ABSOLUTE_DEVIATION, "wind_speed", month, year));
+        queries.push_back(QuerySpec(QuerySpec::MEAN, "temperature", month, year));
+        queries.push_back(QuerySpec(QuerySpec::STANDARD_DEVIATION, "wind_speed", month, year));
+        queries.push_back(QuerySpec(QuerySpec::MEAN_ABSOLUTE_DEVIATION, "temperature", month, year));
+        queries.push_back(QuerySpec(QuerySpec::TOTAL, "solar_radiation", month, year));
+    }
+    std::vector<float> results = stations.evaluateBatch(queries);
+
+    for (int month = 1; month <= 12; ++month) {
+        const float* row = &results[(month - 1) * COLUMNS];
+        float avgWindSpeed = row[0];
+        float windSpeedStdev = row[1];
+        float windSpeedMAD = row[2];
+        float avgTemp = row[3];
+        float tempStdev = row[4];
+        float tempMAD = row[5];
+        float totalRadiation = row[6];
+
+        writer.writeInteger(month);
+        writer.writeText(", ");
+        writer.writeFloat(avgWindSpeed, 2);
+        writer.writeText(" (");
+        writer.writeFloat(windSpeedStdev, 2);
+        writer.writeText(", ");
+        writer.writeFloat(windSpeedMAD, 2);
+        writer.writeText("), ");
+        writer.writeFloat(avgTemp, 2);
+        writer.writeText(" (");
+        writer.writeFloat(tempStdev, 2);
+        writer.writeText(", ");
+        writer.writeFloat(tempMAD, 2);
+        writer.writeText("), ");
+        writer.writeFloat(totalRadiation, 2);
+        writer.writeText("\n");
+    }
+}
@@ -0,0 +1,168 @@
+#ifndef WEATHERDATASET_H
+#define WEATHERDATASET_H
+
+#include "StationStore.h"
+#include "QuerySpec.h"
+#include "RangeQuery.h"
+#include "BatchReport.h"
+#include "ReportWriter.h"
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A loaded weather dataset: the entry point for programs that embed the engine.
+ *
+ * The dataset loads logger files into per-station storage, builds the indexes, answers
+ * queries and writes reports. Loading takes the dataset exclusively, while queries and
+ * reports share it, so one loaded dataset can serve any number of threads at once and
+ * more data can be loaded between queries.
+ */
+class WeatherDataset {
+public:
+    /**
+     * @brief Constructs an empty dataset.
+     *
+     * @param threadCount The number of worker threads for queries across stations, or 0 to use one per hardware thread.
+     */
+    WeatherDataset(size_t threadCount = 0);
+
+    /**
+     * @brief Adds the files named in a source list and loads them.
+     *
+     * Each line names a file relative to the directory of the list. A line "[name]" starts
+     * the files of station "name"; files listed before any station belong to the default station.
+     *
+     * @param filename The name of the source list.
+     * @param error Receives the reason if the list cannot be read.
+     * @return true if the list was read, false otherwise. Files that cannot be read are reported by getErrors.
+     */
+    bool loadSourceList(const std::string& filename, std::string& error);
+
+    /**
+     * @brief Adds a file to be read by the next call to load.
+     *
+     * @param filename The name of the file.
+     * @param station The name of the station the file belongs to.
+     */
+    void addFile(const std::string& filename, const std::string& station = StationStore::DEFAULT_STATION);
+
+    /**
+     * @brief Loads the files added since the last load.
+     */
+    void load();
+
+    /**
+     * @brief Adds a single record to a station.
+     *
+     * @param station The name of the station.
+     * @param record The record to add.
+     */
+    void add(const std::string& station, const WindTempSolar& record);
+
+    /**
+     * @brief Builds the ordered and timestamp indexes of every station.
+     *
+     * Indexes are otherwise built by the first query that needs them.
+     */
+    void buildIndexes() const;
+
+    /**
+     * @brief Returns the messages of files that could not be read, over all loads.
+     *
+     * @return The error messages.
+     */
+    std::vector<std::string> getErrors() const;
+
+    /**
+     * @brief Returns the number of malformed rows skipped, over all loads.
+     *
+     * @return The number of malformed rows.
+     */
+    long long getMalformedCount() const;
+
+    /**
+     * @brief Returns the number of missing or invalid values of a field, over all loads.
+     *
+     * @param fieldIndex The field index (see WindTempSolar::getValue).
+     * @return The number of invalid values.
+     */
+    long long getInvalidCount(int fieldIndex) const;
+
+    /**
+     * @brief Returns the number of records of all stations.
+     *
+     * @return The number of records.
+     */
+    long long getRecordCount() const;
+
+    /**
+     * @brief Returns the identifier of a station.
+     *
+     * @param name The name of the station.
+     * @return The station identifier, or -1 if there is no station with that name.
+     */
+    int findStation(const std::string& name) const;
+
+    /**
+     * @brief Evaluates a single query.
+     *
+     * @param query The query to evaluate.
+     * @param stationId The station to query, or StationStore::ALL_STATIONS.
+     * @return The result of the query.
+     */
+    float evaluate(const QuerySpec& query, int stationId = StationStore::ALL_STATIONS) const;
+
+    /**
+     * @brief Evaluates a list of queries as one batch.
+     *
+     * @param queries The queries to evaluate.
+     * @param stationId The station to query, or StationStore::ALL_STATIONS.
+     * @return The results, in the same order as the queries.
+     */
+    std::vector<float> evaluateBatch(const std::vector<QuerySpec>& queries, int stationId = StationStore::ALL_STATIONS) const;
+
+    /**
+     * @brief Evaluates a range query.
+     *
+     * @param query The time range and grouping.
+     * @param stationId The station to query, or StationStore::ALL_STATIONS.
+     * @return The summaries of the groups that contain data, in chronological order.
+     */
+    std::vector<GroupResult> evaluateRange(const RangeQuery& query, int stationId = StationStore::ALL_STATIONS) const;
+
+    /**
+     * @brief Evaluates the queries of a batch report and writes the report.
+     *
+     * @param reports The report specifications.
+     * @param writer The writer receiving the report.
+     * @param stationId The station to report on, or StationStore::ALL_STATIONS.
+     */
+    void writeReport(const BatchReport& reports, ReportWriter& writer, int stationId = StationStore::ALL_STATIONS) const;
+
+    /**
+     * @brief Writes the monthly wind, temperature and solar radiation report of a year.
+     *
+     * Each line holds the month, the average wind speed with its standard deviation and
+     * mean absolute deviation, the average temperature with its deviations and the total
+     * solar radiation, with two decimals.
+     *
+     * @param year The year.
+     * @param writer The writer receiving the report.
+     */
+    void writeMonthlyReport(int year, ReportWriter& writer) const;
+
+private:
+    WeatherDataset(const WeatherDataset&);
+    WeatherDataset& operator=(const WeatherDataset&);
+
+    StationStore stations;                                      /**< The records, summaries and calculators of each station. */
+    std::vector<std::pair<std::string, std::string> > pending;  /**< Files (name, station) waiting for the next load. */
+    std::vector<std::string> errors;                            /**< Messages of files that could not be read. */
+    long long malformedCount;                                   /**< Malformed rows skipped. */
+    long long invalidCounts[WindTempSolar::FIELD_COUNT];        /**< Missing or invalid values of each field. */
+    mutable std::shared_mutex mutex;                            /**< Exclusive for loading, shared for queries. */
+};
+
+#endif // WEATHERDATASET_H
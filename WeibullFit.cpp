@@ -0,0 +1,61 @@
+#include "WeibullFit.h"
+#include <cmath>
+
+// Default constructor creates an invalid fit
+WeibullFit::WeibullFit() : shape(0), scale(0), valid(false) {}
+
+// Constructor creates a fit with the given parameters
+WeibullFit::WeibullFit(float shape, float scale) : shape(shape), scale(scale), valid(shape > 0 && scale > 0) {}
+
+// Fits the parameters by linear regression on the Weibull plot of the cumulative frequencies
+WeibullFit WeibullFit::fromHistogram(const Histogram& histogram) {
+    // Only positive wind speeds can be placed on the Weibull plot
+    long long total = histogram.getTotal() - histogram.getUnderflow();
+    long long cumulative = 0;
+    int firstBin = 0;
+    while (firstBin < histogram.getBinCount() && histogram.getBinStart(firstBin) < 0) {
+        total -= histogram.getCount(firstBin);
+        firstBin++;
+    }
+    if (total <= 0) return WeibullFit();
+
+    double sumX = 0, sumY = 0, sumXY = 0, sumXX = 0;
+    int points = 0;
+    for (int bin = firstBin; bin < histogram.getBinCount(); ++bin) {
+        cumulative += histogram.getCount(bin);
+        double edge = histogram.getBinStart(bin) + histogram.getBinWidth();
+        double frequency = (double)cumulative / total;
+        // ln(-ln(1 - F)) is undefined at F = 0 and F = 1
+        if (edge <= 0 || frequency <= 0 || frequency >= 1) continue;
+        double x = std::log(edge);
+        double y = std::log(-std::log(1 - frequency));
+        sumX += x;
+        sumY += y;
+        sumXY += x * y;
+        sumXX += x * x;
+        points++;
+    }
+    if (points < 2) return WeibullFit();
+
+    double denominator = points * sumXX - sumX * sumX;
+    if (denominator == 0) return WeibullFit();
+    double slope = (points * sumXY - sumX * sumY) / denominator;
+    double intercept = (sumY - slope * sumX) / points;
+    if (slope <= 0) return WeibullFit();
+    return WeibullFit((float)slope, (float)std::exp(-intercept / slope));
+}
+
+// Returns the shape parameter k
+float WeibullFit::getShape() const {
+    return shape;
+}
+
+// Returns the scale parameter c
+float WeibullFit::getScale() const {
+    return scale;
+}
+
+// Checks whether the fit succeeded
+bool WeibullFit::isValid() const {
+    return valid;
+}
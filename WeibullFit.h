@@ -0,0 +1,65 @@
+#ifndef WEIBULLFIT_H
+#define WEIBULLFIT_H
+
+#include "Histogram.h"
+
+/**
+ * @brief Weibull distribution parameters fitted to a wind speed histogram.
+ *
+ * The fit uses least squares on the Weibull plot: for each bin edge v with cumulative
+ * frequency F(v), ln(-ln(1 - F)) is linear in ln(v) with slope k (shape) and intercept
+ * -k ln(c) (c is the scale). Underflow and bins below zero are excluded from the fit.
+ */
+class WeibullFit {
+public:
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs an invalid fit with zero parameters.
+     */
+    WeibullFit();
+
+    /**
+     * @brief Constructs a fit with the given parameters.
+     *
+     * @param shape The shape parameter k.
+     * @param scale The scale parameter c.
+     */
+    WeibullFit(float shape, float scale);
+
+    /**
+     * @brief Fits Weibull parameters to a histogram.
+     *
+     * @param histogram The histogram of wind speeds.
+     * @return The fitted parameters, invalid if the histogram has too few populated bins.
+     */
+    static WeibullFit fromHistogram(const Histogram& histogram);
+
+    /**
+     * @brief Returns the shape parameter k.
+     *
+     * @return The shape parameter.
+     */
+    float getShape() const;
+
+    /**
+     * @brief Returns the scale parameter c.
+     *
+     * @return The scale parameter, in the units of the histogram.
+     */
+    float getScale() const;
+
+    /**
+     * @brief Checks whether the fit succeeded.
+     *
+     * @return true if the parameters are valid, false otherwise.
+     */
+    bool isValid() const;
+
+private:
+    float shape;    /**< Shape parameter k. */
+    float scale;    /**< Scale parameter c. */
+    bool valid;     /**< Whether the fit succeeded. */
+};
+
+#endif // WEIBULLFIT_H
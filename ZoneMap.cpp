@@ -0,0 +1,86 @@
+#include "ZoneMap.h"
+#include <cmath>
+
+// Default constructor creates an empty zone map
+ZoneMap::ZoneMap() : recordCount(0) {}
+
+// Extends the zones with the records appended since the previous update
+void ZoneMap::update(const Vector<WindTempSolar>& data) {
+    for (int i = recordCount; i < data.size(); ++i) {
+        const WindTempSolar& record = data[i];
+        long long timestamp = record.getTimestamp();
+        if (i % BLOCK_SIZE == 0) {
+            // First record of a new block
+            Zone zone;
+            zone.minTimestamp = timestamp;
+            zone.maxTimestamp = timestamp;
+            for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+                float value = record.getValue(f);
+                zone.hasNaN[f] = std::isnan(value);
+                zone.min[f] = zone.hasNaN[f] ? INFINITY : value;
+                zone.max[f] = zone.hasNaN[f] ? -INFINITY : value;
+            }
+            zones.push_back(zone);
+            continue;
+        }
+        Zone& zone = zones.back();
+        if (timestamp < zone.minTimestamp) zone.minTimestamp = timestamp;
+        if (timestamp > zone.maxTimestamp) zone.maxTimestamp = timestamp;
+        for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+            float value = record.getValue(f);
+            if (std::isnan(value)) {
+                zone.hasNaN[f] = true;
+                continue;
+            }
+            if (value < zone.min[f]) zone.min[f] = value;
+            if (value > zone.max[f]) zone.max[f] = value;
+        }
+    }
+    recordCount = data.size();
+}
+
+// Returns the number of records covered by the zone map
+int ZoneMap::getRecordCount() const {
+    return recordCount;
+}
+
+// Returns the number of blocks
+int ZoneMap::getBlockCount() const {
+    return (int)zones.size();
+}
+
+// Returns the index of the first record of a block
+int ZoneMap::getBlockBegin(int block) const {
+    return block * BLOCK_SIZE;
+}
+
+// Returns the index one past the last record of a block
+int ZoneMap::getBlockEnd(int block) const {
+    int end = (block + 1) * BLOCK_SIZE;
+    return (end < recordCount) ? end : recordCount;
+}
+
+// Checks whether a block may contain records in the time window
+bool ZoneMap::overlapsTime(int block, long long start, long long end) const {
+    return zones[block].maxTimestamp >= start && zones[block].minTimestamp < end;
+}
+
+// Checks whether every record of a block lies in the time window
+bool ZoneMap::containedInTime(int block, long long start, long long end) const {
+    return zones[block].minTimestamp >= start && zones[block].maxTimestamp < end;
+}
+
+// Checks whether a block may contain values in the range
+bool ZoneMap::overlapsValues(int block, int fieldIndex, float minValue, float maxValue) const {
+    return zones[block].max[fieldIndex] >= minValue && zones[block].min[fieldIndex] <= maxValue;
+}
+
+// Checks whether every value of a block lies in the range
+bool ZoneMap::containedInValues(int block, int fieldIndex, float minValue, float maxValue) const {
+    return !zones[block].hasNaN[fieldIndex] && zones[block].min[fieldIndex] >= minValue && zones[block].max[fieldIndex] <= maxValue;
+}
+
+// Checks whether a block has NaN values of a field
+bool ZoneMap::hasInvalidValues(int block, int fieldIndex) const {
+    return zones[block].hasNaN[fieldIndex];
+}
@@ -0,0 +1,133 @@
+#ifndef ZONEMAP_H
+#define ZONEMAP_H
+
+#include "Vector.h"
+#include "WindTempSolar.h"
+#include <vector>
+
+/**
+ * @brief Per-block min/max metadata over a record vector, used to skip blocks in queries.
+ *
+ * The records are divided into consecutive blocks of BLOCK_SIZE. For each block the zone
+ * map keeps the timestamp range and the minimum and maximum of every field, so a query
+ * with a time window or a value predicate can skip blocks that cannot contain a match,
+ * and can count blocks that match entirely without looking at their records.
+ */
+class ZoneMap {
+public:
+    /** Number of records per block. */
+    static const int BLOCK_SIZE = 1024;
+
+    /**
+     * @brief Default constructor.
+     *
+     * Constructs an empty zone map.
+     */
+    ZoneMap();
+
+    /**
+     * @brief Brings the zone map up to date with the records of a vector.
+     *
+     * Records are only ever appended to the vector, so only the records added since the
+     * previous call are processed.
+     *
+     * @param data Vector of WindTempSolar objects.
+     */
+    void update(const Vector<WindTempSolar>& data);
+
+    /**
+     * @brief Returns the number of records covered by the zone map.
+     *
+     * @return The number of records.
+     */
+    int getRecordCount() const;
+
+    /**
+     * @brief Returns the number of blocks.
+     *
+     * @return The number of blocks.
+     */
+    int getBlockCount() const;
+
+    /**
+     * @brief Returns the index of the first record of a block.
+     *
+     * @param block The index of the block.
+     * @return The index of the first record.
+     */
+    int getBlockBegin(int block) const;
+
+    /**
+     * @brief Returns the index one past the last record of a block.
+     *
+     * @param block The index of the block.
+     * @return The index one past the last record.
+     */
+    int getBlockEnd(int block) const;
+
+    /**
+     * @brief Checks whether a block may contain records in the time window [start, end).
+     *
+     * @param block The index of the block.
+     * @param start The start of the window in minutes since 1 January 1970.
+     * @param end The end of the window in minutes since 1 January 1970.
+     * @return false if no record of the block can be in the window.
+     */
+    bool overlapsTime(int block, long long start, long long end) const;
+
+    /**
+     * @brief Checks whether every record of a block lies in the time window [start, end).
+     *
+     * @param block The index of the block.
+     * @param start The start of the window.
+     * @param end The end of the window.
+     * @return true if the whole block is in the window.
+     */
+    bool containedInTime(int block, long long start, long long end) const;
+
+    /**
+     * @brief Checks whether a block may contain values of a field in [minValue, maxValue].
+     *
+     * @param block The index of the block.
+     * @param fieldIndex The index of the field (see WindTempSolar::getFieldIndex).
+     * @param minValue The lowest accepted value.
+     * @param maxValue The highest accepted value.
+     * @return false if no record of the block can match.
+     */
+    bool overlapsValues(int block, int fieldIndex, float minValue, float maxValue) const;
+
+    /**
+     * @brief Checks whether every value of a field in a block lies in [minValue, maxValue].
+     *
+     * @param block The index of the block.
+     * @param fieldIndex The index of the field.
+     * @param minValue The lowest accepted value.
+     * @param maxValue The highest accepted value.
+     * @return true if every record of the block matches.
+     */
+    bool containedInValues(int block, int fieldIndex, float minValue, float maxValue) const;
+
+    /**
+     * @brief Checks whether a block has invalid (NaN) values of a field.
+     *
+     * @param block The index of the block.
+     * @param fieldIndex The index of the field.
+     * @return true if some record of the block has a NaN value of the field.
+     */
+    bool hasInvalidValues(int block, int fieldIndex) const;
+
+private:
+    // Zone holds the ranges of one block
+    struct Zone {
+        long long minTimestamp;                     ///< Earliest timestamp in the block
+        long long maxTimestamp;                     ///< Latest timestamp in the block
+        float min[WindTempSolar::FIELD_COUNT];      ///< Minimum of each field
+        float max[WindTempSolar::FIELD_COUNT];      ///< Maximum of each field
+        bool hasNaN[WindTempSolar::FIELD_COUNT];    ///< Whether a field has values that compare false
+    };
+
+    std::vector<Zone> zones;    /**< One zone per block. */
+    int recordCount;            /**< Number of records covered. */
+};
+
+#endif // ZONEMAP_H
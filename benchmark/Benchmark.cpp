@@ -0,0 +1,505 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "WeatherGenerator.h"
+#include "StationStore.h"
+#include "IngestPipeline.h"
+#include "ReportWriter.h"
+#include "CompressedSeries.h"
+#include "Math.h"
+#include "Bst.h"
+
+namespace {
+// Settings taken from the command line
+struct Options {
+    std::vector<int> sizes;             // Years of data per run
+    int stations = 1;
+    unsigned long long seed = 20240101ull;
+    double missingRate = 0.001;
+    std::string output;                 // JSON result file, standard output if empty
+    std::string workDir = "benchmark_data";
+    bool smoke = false;                 // One small run to check that everything works
+};
+
+// One measurement, written as one JSON object
+struct Result {
+    std::string benchmark;
+    long long records;
+    double seconds;
+    long long items;                    // Operations, queries or records processed
+    double bytes;                       // Bytes processed, 0 if not meaningful
+    double value;                       // Benchmark-specific value (ratio, error, checksum), NaN if none
+};
+
+// Metrics timed one batch at a time
+struct MetricCase {
+    const char* name;
+    QuerySpec::Metric metric;
+    const char* field;
+    const char* field2;
+    float percentile;
+};
+
+const MetricCase METRIC_CASES[] = {
+    { "mean", QuerySpec::MEAN, "wind_speed", "", 0 },
+    { "stdev", QuerySpec::STANDARD_DEVIATION, "wind_speed", "", 0 },
+    { "mad", QuerySpec::MEAN_ABSOLUTE_DEVIATION, "wind_speed", "", 0 },
+    { "total", QuerySpec::TOTAL, "solar_radiation", "", 0 },
+    { "min", QuerySpec::MIN, "temperature", "", 0 },
+    { "max", QuerySpec::MAX, "temperature", "", 0 },
+    { "count", QuerySpec::COUNT, "wind_speed", "", 0 },
+    { "correlation", QuerySpec::CORRELATION, "wind_speed", "temperature", 0 },
+    { "p95", QuerySpec::PERCENTILE, "wind_speed", "", 95 },
+    { "approx95", QuerySpec::APPROXIMATE_PERCENTILE, "wind_speed", "", 95 },
+    { "medianad", QuerySpec::MEDIAN_ABSOLUTE_DEVIATION, "temperature", "", 0 },
+    { "coverage", QuerySpec::COVERAGE, "wind_speed", "", 0 }
+};
+
+const int FIRST_YEAR = 2000;
+
+long long visitedRecords = 0;
+
+// Counts the records visited by a tree traversal
+void countRecord(WindTempSolar) {
+    visitedRecords++;
+}
+
+// Measures the wall-clock time since construction
+class Stopwatch {
+public:
+    Stopwatch() : start(std::chrono::steady_clock::now()) {}
+    double seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+// Parses a comma-separated list of positive integers
+bool parseSizes(const std::string& text, std::vector<int>& sizes) {
+    std::stringstream stream(text);
+    std::string item;
+    sizes.clear();
+    while (std::getline(stream, item, ',')) {
+        int years = std::atoi(item.c_str());
+        if (years <= 0) return false;
+        sizes.push_back(years);
+    }
+    return !sizes.empty();
+}
+
+// Prints the command-line usage
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--years N[,N]...] [--stations N] [--seed S] [--missing RATE]\n"
+              << "       [--work-dir <dir>] [--output <file>] [--smoke]\n"
+              << "Generates synthetic station files of each size in the work directory and writes the\n"
+              << "timings as JSON. --smoke runs a single one-year pass for a quick check." << std::endl;
+}
+
+// Builds one query of a metric case
+QuerySpec makeQuery(const MetricCase& metricCase, int month, int year) {
+    QuerySpec query(metricCase.metric, metricCase.field, month, year, metricCase.field2);
+    if (metricCase.percentile > 0) query.withPercentile(metricCase.percentile);
+    return query;
+}
+
+// Copies every station into another store, so that timings start with empty result caches
+void copyStations(const StationStore& from, StationStore& to) {
+    for (int s = 0; s < from.getStationCount(); ++s) {
+        const Station& station = from.getStation(s);
+        int id = to.addStation(station.getName());
+        const Vector<WindTempSolar>& data = station.getData();
+        for (int i = 0; i < data.size(); ++i) {
+            to.add(id, data[i]);
+        }
+    }
+}
+
+// Adds a result, printing a progress line
+void addResult(std::vector<Result>& results, const std::string& benchmark, long long records, double seconds, long long items, double bytes = 0, double value = NAN) {
+    Result result = { benchmark, records, seconds, items, bytes, value };
+    results.push_back(result);
+    std::cerr << "  " << benchmark << ": " << seconds << " s" << std::endl;
+}
+
+// Generates the files of one size and loads them through the ingest pipeline
+bool benchmarkIngest(const Options& options, int years, StationStore& stations, std::vector<Result>& results) {
+    std::string directory = options.workDir + "/years" + std::to_string(years);
+    std::error_code code;
+    std::filesystem::create_directories(directory, code);
+
+    WeatherGenerator generator(options.seed);
+    generator.setMissingRate(options.missingRate);
+    std::vector<std::string> files;
+    long long rows = 0;
+    double bytes = 0;
+    Stopwatch generateTimer;
+    for (int s = 0; s < options.stations; ++s) {
+        std::string filename = directory + "/station" + std::to_string(s) + ".csv";
+        std::string error;
+        long long written = generator.writeFile(filename, s, FIRST_YEAR, years, error);
+        if (written < 0) {
+            std::cerr << "Error: " << error << std::endl;
+            return false;
+        }
+        rows += written;
+        bytes += (double)std::filesystem::file_size(filename, code);
+        files.push_back(filename);
+    }
+    addResult(results, "generate", rows, generateTimer.seconds(), rows, bytes);
+
+    IngestPipeline pipeline;
+    for (size_t i = 0; i < files.size(); ++i) {
+        pipeline.addFile(files[i], stations.addStation("station" + std::to_string(i)));
+    }
+    Stopwatch ingestTimer;
+    pipeline.run(stations);
+    addResult(results, "ingest", rows, ingestTimer.seconds(), pipeline.getRecordCount(), bytes);
+    for (size_t i = 0; i < pipeline.getErrors().size(); ++i) {
+        std::cerr << pipeline.getErrors()[i] << std::endl;
+    }
+    return pipeline.getErrors().empty() && pipeline.getRecordCount() == rows;
+}
+
+// Times a batch of queries, first cold and then from the result cache
+void benchmarkBatch(const StationStore& stations, const std::string& name, const std::vector<QuerySpec>& queries, std::vector<Result>& results) {
+    for (int pass = 0; pass < 2; ++pass) {
+        Stopwatch timer;
+        std::vector<float> values = stations.evaluateBatch(queries);
+        double seconds = timer.seconds();
+        double checksum = 0;
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (!std::isnan(values[i])) checksum += values[i];
+        }
+        addResult(results, name + (pass == 0 ? "" : " cached"), stations.getRecordCount(), seconds, (long long)queries.size(), 0, checksum);
+    }
+}
+
+// Times each metric over every month of every year, and window metrics over every day and every hour of the first year
+void benchmarkQueries(const StationStore& loaded, int years, std::vector<Result>& results) {
+    StationStore stations;
+    copyStations(loaded, stations);
+    for (size_t c = 0; c < sizeof(METRIC_CASES) / sizeof(METRIC_CASES[0]); ++c) {
+        const MetricCase& metricCase = METRIC_CASES[c];
+        std::vector<QuerySpec> queries;
+        for (int year = FIRST_YEAR; year < FIRST_YEAR + years; ++year) {
+            for (int month = 1; month <= 12; ++month) {
+                queries.push_back(makeQuery(metricCase, month, year));
+            }
+        }
+        benchmarkBatch(stations, std::string("query ") + metricCase.name, queries, results);
+    }
+
+    const long long minutesPerDay = 24 * 60;
+    long long first = Date(1, 1, FIRST_YEAR).toDayNumber();
+    long long last = Date(1, 1, FIRST_YEAR + 1).toDayNumber();
+    std::vector<QuerySpec> daily;
+    std::vector<QuerySpec> hourly;
+    for (long long day = first; day < last; ++day) {
+        daily.push_back(QuerySpec::window(QuerySpec::MEAN, "temperature", day * minutesPerDay, (day + 1) * minutesPerDay));
+        for (int hour = 0; hour < 24; ++hour) {
+            long long start = day * minutesPerDay + hour * 60;
+            hourly.push_back(QuerySpec::window(QuerySpec::TOTAL, "solar_radiation", start, start + 60));
+        }
+    }
+    benchmarkBatch(stations, "query daily mean", daily, results);
+    benchmarkBatch(stations, "query hourly total", hourly, results);
+}
+
+// Produces the menu option 4 report for every year, the way main does
+void benchmarkReport(const StationStore& loaded, int years, std::vector<Result>& results) {
+    StationStore stations;
+    copyStations(loaded, stations);
+    std::ostringstream text;
+    Stopwatch timer;
+    for (int year = FIRST_YEAR; year < FIRST_YEAR + years; ++year) {
+        ReportWriter output(text);
+        output.writeText("Month, Average Wind Speed (km/h) (stdev, mad), Average Ambient Air Temperature (stdev, mad), Total Solar Radiation (kWh/m^2)\n");
+        for (int month = 1; month <= 12; ++month) {
+            float values[] = {
+                stations.evaluate(QuerySpec(QuerySpec::MEAN, "wind_speed", month, year)),
+                stations.evaluate(QuerySpec(QuerySpec::STANDARD_DEVIATION, "wind_speed", month, year)),
+                stations.evaluate(QuerySpec(QuerySpec::MEAN_ABSOLUTE_DEVIATION, "wind_speed", month, year)),
+                stations.evaluate(QuerySpec(QuerySpec::MEAN, "temperature", month, year)),
+                stations.evaluate(QuerySpec(QuerySpec::STANDARD_DEVIATION, "wind_speed", month, year)),
+                stations.evaluate(QuerySpec(QuerySpec::MEAN_ABSOLUTE_DEVIATION, "temperature", month, year)),
+                stations.evaluate(QuerySpec(QuerySpec::TOTAL, "solar_radiation", month, year))
+            };
+            output.writeInteger(month);
+            for (int v = 0; v < 7; ++v) {
+                output.writeText(", ");
+                output.writeFloat(values[v], 2);
+            }
+            output.writeText("\n");
+        }
+        output.finish();
+    }
+    addResult(results, "menu option 4 report", stations.getRecordCount(), timer.seconds(), years, (double)text.str().size());
+}
+
+// Writes every record through each report format to memory
+void benchmarkWriter(const StationStore& stations, std::vector<Result>& results) {
+    const char* names[] = { "write csv", "write json", "write binary" };
+    ReportWriter::Format formats[] = { ReportWriter::CSV, ReportWriter::JSON, ReportWriter::BINARY };
+    std::vector<std::string> columns;
+    columns.push_back("timestamp");
+    columns.push_back("wind_speed");
+    columns.push_back("temperature");
+    columns.push_back("solar_radiation");
+    for (int f = 0; f < 3; ++f) {
+        std::ostringstream out;
+        ReportWriter writer(out, formats[f]);
+        writer.setColumns(columns);
+        Stopwatch timer;
+        long long rows = 0;
+        for (int s = 0; s < stations.getStationCount(); ++s) {
+            const Vector<WindTempSolar>& data = stations.getStation(s).getData();
+            for (int i = 0; i < data.size(); ++i) {
+                writer.beginRow();
+                writer.addInteger(data[i].getTimestamp());
+                writer.addFloat(data[i].getWindSpeed(), 2);
+                writer.addFloat(data[i].getTemperature(), 2);
+                writer.addFloat(data[i].getSolarRadiation(), 2);
+                writer.endRow();
+                rows++;
+            }
+        }
+        writer.finish();
+        addResult(results, names[f], stations.getRecordCount(), timer.seconds(), rows, (double)writer.getBytesWritten());
+    }
+}
+
+// Compares building the tree one insert at a time with the sorted bulk load, then times searches and traversals
+void benchmarkTree(const StationStore& stations, std::vector<Result>& results) {
+    const Station& station = stations.getStation(0);
+    const Vector<WindTempSolar>& data = station.getData();
+    long long records = data.size();
+
+    Bst<WindTempSolar> tree;
+    Stopwatch insertTimer;
+    for (int i = 0; i < data.size(); ++i) {
+        tree.insert(data[i]);
+    }
+    addResult(results, "bst insert", records, insertTimer.seconds(), records);
+
+    Stopwatch loadTimer;
+    const Bst<WindTempSolar>& loadedTree = station.getStore().getTree();
+    addResult(results, "bst sorted bulk load", records, loadTimer.seconds(), records);
+
+    Stopwatch searchTimer;
+    long long found = 0;
+    for (int i = 0; i < data.size(); i += 7) {
+        if (loadedTree.search(data[i])) found++;
+    }
+    addResult(results, "bst search", records, searchTimer.seconds(), (data.size() + 6) / 7, 0, (double)found);
+
+    visitedRecords = 0;
+    Stopwatch traversalTimer;
+    loadedTree.inOrderTraversal(countRecord);
+    addResult(results, "bst in-order traversal", records, traversalTimer.seconds(), visitedRecords);
+
+    visitedRecords = 0;
+    Stopwatch indexTimer;
+    station.getStore().orderedTraversal(countRecord);
+    addResult(results, "ordered index traversal", records, indexTimer.seconds(), visitedRecords);
+}
+
+// Measures how far the digest percentiles are from the exact ones, as the mean relative error
+void benchmarkPercentileError(const StationStore& stations, int years, std::vector<Result>& results) {
+    const float percentiles[] = { 50, 95, 99 };
+    for (int p = 0; p < 3; ++p) {
+        std::vector<QuerySpec> exact;
+        std::vector<QuerySpec> approximate;
+        for (int year = FIRST_YEAR; year < FIRST_YEAR + years; ++year) {
+            for (int month = 1; month <= 12; ++month) {
+                exact.push_back(QuerySpec(QuerySpec::PERCENTILE, "wind_speed", month, year).withPercentile(percentiles[p]));
+                approximate.push_back(QuerySpec(QuerySpec::APPROXIMATE_PERCENTILE, "wind_speed", month, year).withPercentile(percentiles[p]));
+            }
+        }
+        std::vector<float> exactValues = stations.evaluateBatch(exact);
+        Stopwatch timer;
+        std::vector<float> approximateValues = stations.evaluateBatch(approximate);
+        double seconds = timer.seconds();
+        double error = 0;
+        for (size_t i = 0; i < exactValues.size(); ++i) {
+            if (exactValues[i] != 0) error += std::abs(approximateValues[i] - exactValues[i]) / std::abs(exactValues[i]);
+        }
+        std::string name = "percentile p" + std::to_string((int)percentiles[p]) + " relative error";
+        addResult(results, name, stations.getRecordCount(), seconds, (long long)exact.size(), 0, error / exactValues.size());
+    }
+}
+
+// Compresses one station and compares month scans over the compressed blocks and the record store
+void benchmarkCompression(const StationStore& stations, int years, std::vector<Result>& results) {
+    const Station& station = stations.getStation(0);
+    long long records = station.getRecordCount();
+    double rawBytes = (double)records * sizeof(WindTempSolar);
+
+    Stopwatch compressTimer;
+    CompressedSeries series = CompressedSeries::compress(station.getData());
+    double seconds = compressTimer.seconds();
+    addResult(results, "compress", records, seconds, records, rawBytes, rawBytes / series.getCompressedBytes());
+
+    int queries = years * 12;
+    double checksum = 0;
+    Stopwatch compressedTimer;
+    for (int year = FIRST_YEAR; year < FIRST_YEAR + years; ++year) {
+        for (int month = 1; month <= 12; ++month) {
+            checksum += Math::calculateAverage(series, "wind_speed", month, year);
+        }
+    }
+    addResult(results, "scan compressed mean", records, compressedTimer.seconds(), queries, (double)series.getCompressedBytes(), checksum);
+
+    checksum = 0;
+    Stopwatch storeTimer;
+    for (int year = FIRST_YEAR; year < FIRST_YEAR + years; ++year) {
+        for (int month = 1; month <= 12; ++month) {
+            checksum += Math::calculateAverage(station.getStore(), "wind_speed", month, year);
+        }
+    }
+    addResult(results, "scan record store mean", records, storeTimer.seconds(), queries, rawBytes, checksum);
+}
+
+// Compares selective counts through the zone map with a loop over every record
+void benchmarkZoneMap(const StationStore& stations, int years, std::vector<Result>& results) {
+    const Station& station = stations.getStation(0);
+    const Vector<WindTempSolar>& data = station.getData();
+    std::vector<long long> starts;
+    std::vector<long long> ends;
+    for (int year = FIRST_YEAR; year < FIRST_YEAR + years; ++year) {
+        long long start, end;
+        QuerySpec(QuerySpec::COUNT, "wind_speed", 7, year).getTimeRange(start, end);
+        starts.push_back(start);
+        ends.push_back(end);
+    }
+    // Strong winds in July of each year: a narrow time window and a rare value range
+    const float minValue = 40;
+    const float maxValue = 1000;
+
+    station.getCalculator().countRecordsInRange("wind_speed", minValue, maxValue, starts[0], ends[0]);
+    long long zoneCount = 0;
+    Stopwatch zoneTimer;
+    for (size_t q = 0; q < starts.size(); ++q) {
+        zoneCount += station.getCalculator().countRecordsInRange("wind_speed", minValue, maxValue, starts[q], ends[q]);
+    }
+    addResult(results, "zone map range count", data.size(), zoneTimer.seconds(), (long long)starts.size(), 0, (double)zoneCount);
+
+    long long naiveCount = 0;
+    Stopwatch naiveTimer;
+    for (size_t q = 0; q < starts.size(); ++q) {
+        for (int i = 0; i < data.size(); ++i) {
+            long long timestamp = data[i].getTimestamp();
+            float value = data[i].getWindSpeed();
+            if (timestamp >= starts[q] && timestamp < ends[q] && value >= minValue && value <= maxValue) naiveCount++;
+        }
+    }
+    addResult(results, "full scan range count", data.size(), naiveTimer.seconds(), (long long)starts.size(), 0, (double)naiveCount);
+}
+
+// Writes the results as a JSON array
+bool writeResults(const Options& options, const std::vector<Result>& results, const std::vector<int>& resultYears) {
+    std::vector<std::string> columns;
+    columns.push_back("benchmark");
+    columns.push_back("years");
+    columns.push_back("stations");
+    columns.push_back("records");
+    columns.push_back("seconds");
+    columns.push_back("items");
+    columns.push_back("items_per_second");
+    columns.push_back("bytes_per_second");
+    columns.push_back("value");
+    columns.push_back("seed");
+
+    std::ostream* out = &std::cout;
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output.c_str());
+        if (!file.is_open()) {
+            std::cerr << "Unable to open file " << options.output << " for writing." << std::endl;
+            return false;
+        }
+        out = &file;
+    }
+    ReportWriter writer(*out, ReportWriter::JSON);
+    writer.setColumns(columns);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        double seconds = result.seconds > 0 ? result.seconds : NAN;
+        writer.beginRow();
+        writer.addText(result.benchmark);
+        writer.addInteger(resultYears[i]);
+        writer.addInteger(options.stations);
+        writer.addInteger(result.records);
+        writer.addFloat((float)result.seconds, 6);
+        writer.addInteger(result.items);
+        writer.addFloat((float)(result.items / seconds), 1);
+        writer.addFloat(result.bytes > 0 ? (float)(result.bytes / seconds) : NAN, 1);
+        writer.addFloat((float)result.value, 6);
+        writer.addInteger((long long)options.seed);
+        writer.endRow();
+    }
+    writer.writeText("\n");
+    return writer.finish() && out->good();
+}
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    options.sizes.push_back(1);
+    options.sizes.push_back(4);
+    options.sizes.push_back(16);
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--smoke") {
+            options.smoke = true;
+        } else if ((arg == "--years" || arg == "--stations" || arg == "--seed" || arg == "--missing" || arg == "--work-dir" || arg == "--output") && i + 1 < argc) {
+            std::string value = argv[++i];
+            bool ok = true;
+            if (arg == "--years") ok = parseSizes(value, options.sizes);
+            else if (arg == "--stations") ok = (options.stations = std::atoi(value.c_str())) > 0;
+            else if (arg == "--seed") options.seed = std::strtoull(value.c_str(), 0, 10);
+            else if (arg == "--missing") ok = (options.missingRate = std::atof(value.c_str())) >= 0 && options.missingRate < 1;
+            else if (arg == "--work-dir") options.workDir = value;
+            else options.output = value;
+            if (!ok) {
+                std::cerr << "Error: invalid value " << value << " for " << arg << std::endl;
+                return 1;
+            }
+        } else {
+            printUsage(argv[0]);
+            return (arg == "--help") ? 0 : 1;
+        }
+    }
+    if (options.smoke) {
+        options.sizes.assign(1, 1);
+    }
+
+    std::vector<Result> results;
+    std::vector<int> resultYears;
+    for (size_t s = 0; s < options.sizes.size(); ++s) {
+        int years = options.sizes[s];
+        std::cerr << years << " year(s), " << options.stations << " station(s)" << std::endl;
+        size_t first = results.size();
+        StationStore stations;
+        if (!benchmarkIngest(options, years, stations, results)) {
+            std::cerr << "Error: the generated files were not loaded completely" << std::endl;
+            return 1;
+        }
+        benchmarkReport(stations, years, results);
+        benchmarkQueries(stations, years, results);
+        benchmarkWriter(stations, results);
+        benchmarkTree(stations, results);
+        benchmarkPercentileError(stations, years, results);
+        benchmarkCompression(stations, years, results);
+        benchmarkZoneMap(stations, years, results);
+        resultYears.resize(resultYears.size() + results.size() - first, years);
+    }
+    return writeResults(options, results, resultYears) ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+#include "WeatherGenerator.h"
+#include "ReportWriter.h"
+#include <cmath>
+
+namespace {
+const double PI = 3.14159265358979323846;
+const double LATITUDE = -32.0 * PI / 180;   // Southern mid-latitude site
+const double WIND_PERSISTENCE = 0.985;      // Correlation of wind from one sample to the next
+const double TEMPERATURE_PERSISTENCE = 0.995;
+const double CLOUD_PERSISTENCE = 0.998;
+
+// Day of the year counted from 1 January, 0-based
+int dayOfYear(long long dayNumber) {
+    Date date = Date::fromDayNumber(dayNumber);
+    return (int)(dayNumber - Date(1, 1, date.getYear()).toDayNumber());
+}
+}
+
+// Constructor stores the seed
+WeatherGenerator::WeatherGenerator(unsigned long long seed) : seed(seed), missingRate(0) {}
+
+// Sets the fraction of blank values
+void WeatherGenerator::setMissingRate(double rate) {
+    missingRate = rate;
+}
+
+// Writes one station's years through a CSV ReportWriter, leaving missing values blank
+long long WeatherGenerator::writeFile(const std::string& filename, int station, int firstYear, int years, std::string& error) {
+    ReportWriter writer(filename, ReportWriter::CSV, 1 << 20);
+    if (!writer.isOpen()) {
+        error = "Unable to open " + filename;
+        return -1;
+    }
+    std::vector<std::string> columns;
+    columns.push_back("WAST");
+    columns.push_back("Time");
+    columns.push_back("S");
+    columns.push_back("T");
+    columns.push_back("SR");
+    writer.setColumns(columns);
+
+    StationState state = startStation(station);
+    unsigned long long missingState = seed ^ (0x5DEECE66Dull * (unsigned long long)(station + 1));
+    long long first = Date(1, 1, firstYear).toDayNumber();
+    long long last = Date(1, 1, firstYear + years).toDayNumber();
+    long long rows = 0;
+    for (long long day = first; day < last; ++day) {
+        std::string date = Date::fromDayNumber(day).toString();
+        for (int minute = 0; minute < 24 * 60; minute += SAMPLE_MINUTES) {
+            WindTempSolar sample = nextSample(state, station, day, minute);
+            float values[WindTempSolar::FIELD_COUNT];
+            for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+                values[f] = sample.getValue(f);
+                if (missingRate > 0 && nextUniform(missingState) < missingRate) values[f] = NAN;
+            }
+            writer.beginRow();
+            writer.addText(date);
+            writer.addText(Time(minute / 60, minute % 60).toString());
+            writer.addFloat(values[0], 1);
+            writer.addFloat(values[1], 1);
+            writer.addFloat(values[2], 0);
+            writer.endRow();
+            rows++;
+        }
+    }
+    if (!writer.finish()) {
+        error = "Unable to write " + filename;
+        return -1;
+    }
+    return rows;
+}
+
+// Seeds a station's sequence and starts its processes at their means
+WeatherGenerator::StationState WeatherGenerator::startStation(int station) const {
+    StationState state;
+    state.random = seed + 0x9E3779B97F4A7C15ull * (unsigned long long)(station + 1);
+    state.windNoise = 0;
+    state.temperatureNoise = 0;
+    state.cloudNoise = 0;
+    return state;
+}
+
+// Advances the noise processes and derives the three values of a sample
+WindTempSolar WeatherGenerator::nextSample(StationState& state, int station, long long dayNumber, int minuteOfDay) const {
+    // Autoregressive noise keeps each value close to the previous sample
+    state.windNoise = WIND_PERSISTENCE * state.windNoise + std::sqrt(1 - WIND_PERSISTENCE * WIND_PERSISTENCE) * nextNormal(state.random);
+    state.temperatureNoise = TEMPERATURE_PERSISTENCE * state.temperatureNoise + 0.2 * nextNormal(state.random);
+    state.cloudNoise = CLOUD_PERSISTENCE * state.cloudNoise + std::sqrt(1 - CLOUD_PERSISTENCE * CLOUD_PERSISTENCE) * nextNormal(state.random);
+
+    double season = std::cos(2 * PI * (dayOfYear(dayNumber) - 20) / 365.25);     // 1 in midsummer (January)
+    double daily = std::cos(2 * PI * (minuteOfDay / 1440.0 - 0.625));           // 1 at 15:00
+
+    double temperature = 18 + 6 * season + 5 * daily + state.temperatureNoise - 1.5 * station;
+
+    // Weibull (shape 2) wind speed in km/h from the normal noise via its uniform quantile
+    double quantile = 0.5 * std::erfc(-state.windNoise / std::sqrt(2.0));
+    if (quantile > 0.999999) quantile = 0.999999;
+    double scale = 16 + 3 * daily + 0.5 * station;
+    double windSpeed = scale * std::sqrt(-std::log(1 - quantile));
+
+    // Clear-sky radiation from the sun's elevation, dimmed by cloud
+    double declination = -23.44 * PI / 180 * std::cos(2 * PI * (dayOfYear(dayNumber) + 10) / 365.25);
+    double hourAngle = 2 * PI * (minuteOfDay / 1440.0 - 0.5);
+    double sinElevation = std::sin(LATITUDE) * std::sin(declination) + std::cos(LATITUDE) * std::cos(declination) * std::cos(hourAngle);
+    double cloud = 0.5 + 0.25 * state.cloudNoise;
+    cloud = (cloud < 0) ? 0 : (cloud > 1 ? 1 : cloud);
+    double solarRadiation = (sinElevation > 0) ? 1000 * std::pow(sinElevation, 1.15) * (1 - 0.7 * cloud) : 0;
+
+    Date date = Date::fromDayNumber(dayNumber);
+    return WindTempSolar(date, Time(minuteOfDay / 60, minuteOfDay % 60), (float)windSpeed, (float)temperature, (float)solarRadiation);
+}
+
+// SplitMix64 step mapped to [0, 1)
+double WeatherGenerator::nextUniform(unsigned long long& state) {
+    state += 0x9E3779B97F4A7C15ull;
+    unsigned long long z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Sum of four uniforms, centred and scaled to unit variance
+double WeatherGenerator::nextNormal(unsigned long long& state) {
+    double sum = nextUniform(state) + nextUniform(state) + nextUniform(state) + nextUniform(state);
+    return (sum - 2) * std::sqrt(3.0);
+}
@@ -0,0 +1,97 @@
+#ifndef WEATHERGENERATOR_H
+#define WEATHERGENERATOR_H
+
+#include "WindTempSolar.h"
+#include <string>
+
+/**
+ * @brief Deterministic generator of synthetic 10-minute weather logger files.
+ *
+ * Records follow the shape of the real data: temperature has a seasonal and a daily cycle with
+ * slowly wandering noise, wind speed is Weibull distributed with persistence from one sample
+ * to the next and a stronger afternoon breeze, and solar radiation follows the sun's elevation
+ * at a southern mid-latitude site, dimmed by drifting cloud cover. Each station is shifted a
+ * little so stations differ.
+ *
+ * The random numbers come from a SplitMix64 sequence and normal deviates are built from sums
+ * of uniforms, so the same seed always gives the same files, independent of the standard
+ * library's distributions.
+ */
+class WeatherGenerator {
+public:
+    /**
+     * @brief Minutes between consecutive samples.
+     */
+    static const int SAMPLE_MINUTES = 10;
+
+    /**
+     * @brief Constructs a generator.
+     *
+     * @param seed The seed; every station's sequence is derived from it.
+     */
+    WeatherGenerator(unsigned long long seed = 20240101ull);
+
+    /**
+     * @brief Sets the fraction of values written as blank (missing) fields.
+     *
+     * @param rate The fraction of values to leave out (0-1).
+     */
+    void setMissingRate(double rate);
+
+    /**
+     * @brief Writes the samples of one station for whole years as a CSV file in the logger format.
+     *
+     * @param filename The name of the file to write.
+     * @param station The number of the station, which selects its sequence and shifts its climate.
+     * @param firstYear The first year.
+     * @param years The number of years.
+     * @param error Receives the reason if the file cannot be written.
+     * @return The number of rows written, or -1 on error.
+     */
+    long long writeFile(const std::string& filename, int station, int firstYear, int years, std::string& error);
+
+private:
+    /**
+     * @brief Continuous state of a station from one sample to the next.
+     */
+    struct StationState {
+        unsigned long long random;  ///< SplitMix64 state
+        double windNoise;           ///< Standard normal driving the wind speed
+        double temperatureNoise;    ///< Temperature deviation in degrees
+        double cloudNoise;          ///< Standard normal driving the cloud cover
+    };
+
+    /**
+     * @brief Starts the sequence of a station.
+     * @param station The number of the station.
+     * @return The initial state.
+     */
+    StationState startStation(int station) const;
+
+    /**
+     * @brief Produces the next sample of a station.
+     * @param state The station state, advanced by the call.
+     * @param station The number of the station.
+     * @param dayNumber The day of the sample (see Date::toDayNumber).
+     * @param minuteOfDay The minute of the day of the sample.
+     * @return The sample.
+     */
+    WindTempSolar nextSample(StationState& state, int station, long long dayNumber, int minuteOfDay) const;
+
+    /**
+     * @brief Returns the next uniform deviate in [0, 1).
+     * @param state The SplitMix64 state, advanced by the call.
+     */
+    static double nextUniform(unsigned long long& state);
+
+    /**
+     * @brief Returns an approximately standard normal deviate (sum of four uniforms).
+     * @param state The SplitMix64 state, advanced by the call.
+     */
+    static double nextNormal(unsigned long long& state);
+
+    unsigned long long seed;    /**< Seed of all sequences. */
+    double missingRate;         /**< Fraction of values written as blank fields. */
+};
+
+#endif // WEATHERGENERATOR_H
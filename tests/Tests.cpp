@@ -0,0 +1,534 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BatchReport.h"
+#include "Bst.h"
+#include "CompressedSeries.h"
+#include "CsvParser.h"
+#include "Math.h"
+#include "Percentile.h"
+#include "ReportWriter.h"
+#include "RollingStatistics.h"
+#include "RollingWindow.h"
+#include "Station.h"
+#include "TDigest.h"
+
+namespace {
+int checkCount = 0;
+int failureCount = 0;
+
+// Records a check, printing the failing expression and its location
+void check(bool passed, const char* expression, const char* file, int line) {
+    ++checkCount;
+    if (!passed) {
+        ++failureCount;
+        std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+    }
+}
+
+#define CHECK(expression) check((expression), #expression, __FILE__, __LINE__)
+
+// Returns true if two results agree within a relative tolerance
+bool near(double actual, double expected, double tolerance) {
+    return std::abs(actual - expected) <= tolerance * std::max(1.0, std::abs(expected));
+}
+
+// Returns true if two floats have the same bits, so NaN equals NaN and -0.0 differs from 0.0
+bool sameBits(float a, float b) {
+    uint32_t x, y;
+    std::memcpy(&x, &a, sizeof(x));
+    std::memcpy(&y, &b, sizeof(y));
+    return x == y;
+}
+
+// Deterministic pseudo-random numbers, so failures can be reproduced
+class Random {
+public:
+    explicit Random(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Returns a value in [0, 1)
+    double uniform() {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+private:
+    uint64_t state;
+};
+
+// Makes a record at a timestamp in minutes since 1 January 1970
+WindTempSolar recordAt(long long timestamp, float windSpeed, float temperature, float solarRadiation) {
+    long long day = timestamp / (24 * 60);
+    int minute = (int)(timestamp % (24 * 60));
+    return WindTempSolar(Date::fromDayNumber(day), Time(minute / 60, minute % 60), windSpeed, temperature, solarRadiation);
+}
+
+// Makes two months of 10-minute records with missing values and a day-long gap in the logging
+std::vector<WindTempSolar> makeRecordsWithGaps(uint64_t seed) {
+    Random random(seed);
+    std::vector<WindTempSolar> records;
+    long long start = Date(1, 3, 2015).toDayNumber() * 24 * 60;
+    long long end = Date(1, 5, 2015).toDayNumber() * 24 * 60;
+    long long gapStart = Date(10, 3, 2015).toDayNumber() * 24 * 60;
+    for (long long t = start; t < end; t += 10) {
+        if (t >= gapStart && t < gapStart + 24 * 60) continue;
+        float windSpeed = (float)(random.uniform() * 40);
+        float temperature = (float)(random.uniform() * 30 - 5);
+        float solarRadiation = (float)(random.uniform() * 900);
+        if (random.uniform() < 0.05) windSpeed = std::numeric_limits<float>::quiet_NaN();
+        if (random.uniform() < 0.05) temperature = std::numeric_limits<float>::quiet_NaN();
+        if (random.uniform() < 0.05) solarRadiation = std::numeric_limits<float>::quiet_NaN();
+        records.push_back(recordAt(t, windSpeed, temperature, solarRadiation));
+    }
+    return records;
+}
+
+// Blank fields, missing markers and logger sentinels are parsed as NaN and counted as invalid
+void testCsvParser() {
+    WindTempSolar record;
+    size_t invalid[WindTempSolar::FIELD_COUNT] = { 0, 0, 0 };
+    CHECK(CsvParser::parseLine("1/3/2015,9:00,12.5,20.25,400", record, invalid));
+    CHECK(record.getWindSpeed() == 12.5f && record.getTemperature() == 20.25f && record.getSolarRadiation() == 400.0f);
+    CHECK(record.getDate().getDay() == 1 && record.getDate().getMonth() == 3 && record.getDate().getYear() == 2015);
+    CHECK(invalid[0] == 0 && invalid[1] == 0 && invalid[2] == 0);
+
+    CHECK(CsvParser::parseLine("1/3/2015,9:10,,20,400\r", record, invalid));
+    CHECK(std::isnan(record.getWindSpeed()) && record.getTemperature() == 20.0f);
+    CHECK(invalid[0] == 1);
+
+    const char* markers[] = { "N/A", "n/a", "NA", "NaN", "-" };
+    for (size_t i = 0; i < sizeof(markers) / sizeof(markers[0]); ++i) {
+        CHECK(CsvParser::parseLine(std::string("1/3/2015,9:20,5,") + markers[i] + ",400", record, invalid));
+        CHECK(std::isnan(record.getTemperature()) && record.getWindSpeed() == 5.0f);
+    }
+    CHECK(invalid[1] == 5);
+
+    const char* sentinels[] = { "-9999", "-999", "9999", "6999" };
+    for (size_t i = 0; i < sizeof(sentinels) / sizeof(sentinels[0]); ++i) {
+        CHECK(CsvParser::parseLine(std::string("1/3/2015,9:30,5,20,") + sentinels[i], record, invalid));
+        CHECK(std::isnan(record.getSolarRadiation()));
+    }
+    CHECK(invalid[2] == 4);
+    CHECK(CsvParser::isSentinel(-9999.0f) && !CsvParser::isSentinel(-99.0f));
+
+    CHECK(!CsvParser::parseLine("1/3/2015,9:40,5,hot,400", record, invalid));
+    CHECK(!CsvParser::parseLine("yesterday,9:40,5,20,400", record, invalid));
+    CHECK(!CsvParser::parseLine("", record, invalid));
+}
+
+// The summary cube and the raw-data scans agree with the masked Math kernels when values and samples are missing
+void testCubeMatchesMaskedKernels() {
+    std::vector<WindTempSolar> records = makeRecordsWithGaps(7);
+    Station station(0, "test");
+    for (size_t i = 0; i < records.size(); ++i) station.add(records[i]);
+    const RecordStore& store = station.getStore();
+
+    const char* fields[] = { "wind_speed", "temperature", "solar_radiation" };
+    for (int month = 3; month <= 4; ++month) {
+        for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+            std::vector<QuerySpec> queries;
+            queries.push_back(QuerySpec(QuerySpec::MEAN, fields[f], month, 2015));
+            queries.push_back(QuerySpec(QuerySpec::STANDARD_DEVIATION, fields[f], month, 2015));
+            queries.push_back(QuerySpec(QuerySpec::TOTAL, fields[f], month, 2015));
+            queries.push_back(QuerySpec(QuerySpec::MEAN_ABSOLUTE_DEVIATION, fields[f], month, 2015));
+            std::vector<float> results = station.getCalculator().evaluateBatch(queries);
+            CHECK(near(results[0], Math::calculateAverage(store, fields[f], month, 2015), 1e-4));
+            CHECK(near(results[1], Math::calculateStandardDeviation(store, fields[f], month, 2015), 1e-3));
+            CHECK(near(results[2], Math::calculateTotal(store, fields[f], month, 2015), 1e-4));
+            CHECK(near(results[3], Math::calculateMAD(store, fields[f], month, 2015), 1e-3));
+            CHECK(!std::isnan(results[0]) && !std::isnan(results[1]));
+        }
+    }
+
+    // Exact percentiles and window averages scan the records through the validity bitmaps
+    for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+        std::vector<float> valid;
+        double windowSum = 0;
+        long long windowCount = 0;
+        long long windowStart = Date(5, 3, 2015).toDayNumber() * 24 * 60 + 7;
+        long long windowEnd = Date(20, 3, 2015).toDayNumber() * 24 * 60 + 13;
+        for (size_t i = 0; i < records.size(); ++i) {
+            float value = records[i].getValue(f);
+            if (std::isnan(value)) continue;
+            if (records[i].getDate().getMonth() == 4) valid.push_back(value);
+            if (records[i].getTimestamp() >= windowStart && records[i].getTimestamp() < windowEnd) {
+                windowSum += value;
+                windowCount++;
+            }
+        }
+        std::vector<QuerySpec> queries;
+        queries.push_back(QuerySpec(QuerySpec::PERCENTILE, fields[f], 4, 2015).withPercentile(90));
+        queries.push_back(QuerySpec(QuerySpec::MEDIAN_ABSOLUTE_DEVIATION, fields[f], 4, 2015));
+        std::vector<float> results = station.getCalculator().evaluateBatch(queries);
+        std::vector<float> copy = valid;
+        CHECK(results[0] == Percentile::calculatePercentile(copy, 90));
+        copy = valid;
+        CHECK(results[1] == Percentile::calculateMedianAbsoluteDeviation(copy));
+        CHECK(near(station.getCalculator().calculateAverageInWindow(fields[f], windowStart, windowEnd), windowSum / windowCount, 1e-4));
+    }
+
+    // A month without data gives 0 rather than NaN
+    std::vector<float> empty = station.getCalculator().evaluateBatch(std::vector<QuerySpec>(1, QuerySpec(QuerySpec::MEAN, "wind_speed", 6, 2015)));
+    CHECK(empty[0] == 0 && Math::calculateAverage(store, "wind_speed", 6, 2015) == 0);
+}
+
+// Gaps are counted with a fixed interval whatever the load order, and repeated timestamps against all earlier records
+void testTimestampChecks() {
+    std::vector<WindTempSolar> records = makeRecordsWithGaps(5);
+    const long long dayMissing = (24 * 60 + 10 - 1) / 10;
+
+    Station ordered(0, "ordered");
+    for (size_t i = 0; i < records.size(); ++i) ordered.add(records[i]);
+    const MonthlySummary& march = ordered.getCube().getSummary(3, 2015);
+    CHECK(ordered.getCube().getSampleMinutes() == 10);
+    CHECK(march.getGapCount() == 1 && march.getMissingSamples() == dayMissing && march.getDuplicateCount() == 0);
+    CHECK(ordered.getCube().getSummary(4, 2015).getGapCount() == 0);
+
+    // Loading the same file again repeats every timestamp, though never twice in a row
+    for (size_t i = 0; i < records.size(); ++i) ordered.add(records[i]);
+    CHECK(march.getDuplicateCount() + ordered.getCube().getSummary(4, 2015).getDuplicateCount() == (long long)records.size());
+    CHECK(march.getGapCount() == 1 && march.getMissingSamples() == dayMissing);
+
+    // A range ending just before April scans March as a partial month, with the same quality counters
+    long long marchStart = Date(1, 3, 2015).toDayNumber() * 24 * 60;
+    std::vector<GroupResult> partial = ordered.getCalculator().evaluateRange(RangeQuery(marchStart, marchStart + 31 * 24 * 60 - 5, RangeQuery::NONE));
+    CHECK(partial.size() == 1);
+    if (!partial.empty()) {
+        const MonthlySummary& scanned = partial[0].summary;
+        CHECK(scanned.getCount() == march.getCount() && scanned.getDuplicateCount() == march.getDuplicateCount());
+        CHECK(scanned.getGapCount() == 1 && scanned.getMissingSamples() == dayMissing);
+        CHECK(scanned.getCoverage("wind_speed") == march.getCoverage("wind_speed"));
+    }
+
+    // Records loaded backwards, or a file whose first step is a gap, count the same gaps
+    Station reversed(1, "reversed");
+    for (size_t i = records.size(); i-- > 0;) reversed.add(records[i]);
+    CHECK(reversed.getCube().getSummary(3, 2015).getGapCount() == 1);
+    CHECK(reversed.getCube().getSummary(3, 2015).getMissingSamples() == dayMissing);
+    CHECK(reversed.getCube().getSummary(3, 2015).getDuplicateCount() == 0);
+
+    Station late(2, "late");
+    long long start = Date(1, 3, 2015).toDayNumber() * 24 * 60;
+    late.add(recordAt(start, 1, 2, 3));
+    late.add(recordAt(start + 60, 1, 2, 3));
+    late.add(recordAt(start + 70, 1, 2, 3));
+    late.add(recordAt(start + 80, 1, 2, 3));
+    CHECK(late.getCube().getSummary(3, 2015).getGapCount() == 1 && late.getCube().getSummary(3, 2015).getMissingSamples() == 5);
+
+    // Filling part of a gap splits it
+    late.add(recordAt(start + 30, 1, 2, 3));
+    CHECK(late.getCube().getSummary(3, 2015).getGapCount() == 2 && late.getCube().getSummary(3, 2015).getMissingSamples() == 4);
+
+    // A configured interval is used from the first step
+    Station configured(3, "configured", 5);
+    for (size_t i = 0; i < records.size() && records[i].getDate().getMonth() == 3 && records[i].getDate().getDay() < 3; ++i) configured.add(records[i]);
+    CHECK(configured.getCube().getSampleMinutes() == 5);
+    CHECK(configured.getCube().getSummary(3, 2015).getGapCount() == 2 * 24 * 6 - 1);
+}
+
+// Compressed blocks decode to the exact bits of the input, in memory and through a file
+void testCompressedSeriesRoundTrip() {
+    std::vector<WindTempSolar> records = makeRecordsWithGaps(11);
+    Random random(13);
+    Vector<WindTempSolar> data;
+    for (size_t i = 0; i < records.size(); ++i) {
+        WindTempSolar record = records[i];
+        if (i % 97 == 0) record.setWindSpeed(-0.0f);
+        if (i % 89 == 0) record.setTemperature(-0.0f);
+        if (i % 301 == 0) record.setSolarRadiation((float)random.uniform() * 1e-7f);
+        data.push_back(record);
+    }
+
+    CompressedSeries series = CompressedSeries::compress(data);
+    CHECK(series.getRecordCount() == data.size());
+    CHECK(series.getBlockCount() == (data.size() + CompressedSeries::BLOCK_SIZE - 1) / CompressedSeries::BLOCK_SIZE);
+
+    std::string filename = "tests_compressed_series.bin";
+    CHECK(series.save(filename));
+    CompressedSeries loaded;
+    CHECK(loaded.load(filename));
+
+    // Truncated or corrupt files are rejected and leave the series unchanged; any file that is
+    // accepted decodes to the number of records it declares
+    std::string bytes;
+    {
+        std::ifstream file(filename.c_str(), std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    std::ofstream(filename.c_str(), std::ios::binary).write(bytes.data(), bytes.size() / 2);
+    CHECK(!loaded.load(filename) && loaded.getRecordCount() == series.getRecordCount());
+    int inconsistent = 0;
+    for (int trial = 0; trial < 300; ++trial) {
+        std::string corrupt = bytes;
+        size_t position = 20 + (size_t)(random.uniform() * (corrupt.size() - 20));
+        corrupt[position] = (char)(corrupt[position] ^ (1 << (int)(random.uniform() * 8)));
+        std::ofstream(filename.c_str(), std::ios::binary).write(corrupt.data(), corrupt.size());
+        CompressedSeries candidate;
+        if (candidate.load(filename)) {
+            Vector<WindTempSolar> output;
+            candidate.decompress(output);
+            if (output.size() != candidate.getRecordCount()) ++inconsistent;
+        }
+    }
+    CHECK(inconsistent == 0);
+    std::ofstream(filename.c_str(), std::ios::binary).write(bytes.data(), bytes.size());
+    CHECK(loaded.load(filename));
+    std::remove(filename.c_str());
+
+    const CompressedSeries* decoded[] = { &series, &loaded };
+    for (int d = 0; d < 2; ++d) {
+        Vector<WindTempSolar> output;
+        decoded[d]->decompress(output);
+        CHECK(output.size() == data.size());
+        int mismatches = 0;
+        for (int i = 0; i < output.size() && i < data.size(); ++i) {
+            if (output[i].getTimestamp() != data[i].getTimestamp()) ++mismatches;
+            for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+                if (!sameBits(output[i].getValue(f), data[i].getValue(f))) ++mismatches;
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+}
+
+// The incremental window statistics equal those recomputed from the valid values in the window
+void testRollingWindow() {
+    Random random(17);
+    const long long durations[] = { 10, 60, 24 * 60 };
+    for (size_t d = 0; d < sizeof(durations) / sizeof(durations[0]); ++d) {
+        RollingWindow window(durations[d]);
+        std::vector<std::pair<long long, float> > values;
+        long long timestamp = 0;
+        int mismatches = 0;
+        for (int i = 0; i < 5000; ++i) {
+            timestamp += 1 + (long long)(random.uniform() * 30);
+            float value = (float)(random.uniform() * 100 - 50);
+            if (random.uniform() < 0.1) value = std::numeric_limits<float>::quiet_NaN();
+            window.push(timestamp, value);
+            values.push_back(std::make_pair(timestamp, value));
+
+            double sum = 0, sumSquares = 0;
+            float minValue = std::numeric_limits<float>::max(), maxValue = -std::numeric_limits<float>::max();
+            long long count = 0;
+            for (size_t j = values.size(); j-- > 0 && values[j].first > timestamp - durations[d];) {
+                if (std::isnan(values[j].second)) continue;
+                sum += values[j].second;
+                sumSquares += (double)values[j].second * values[j].second;
+                minValue = std::min(minValue, values[j].second);
+                maxValue = std::max(maxValue, values[j].second);
+                ++count;
+            }
+            double mean = count == 0 ? 0 : sum / count;
+            double variance = count == 0 ? 0 : sumSquares / count - mean * mean;
+            if (count == 0) minValue = maxValue = 0;
+            if (window.getCount() != count || !near(window.getMean(), mean, 1e-4) || !near(window.getVariance(), variance, 1e-3)
+                || window.getMin() != minValue || window.getMax() != maxValue) {
+                ++mismatches;
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+
+    RollingWindow empty(60);
+    CHECK(empty.getCount() == 0 && empty.getMean() == 0 && empty.getVariance() == 0);
+
+    // A missing sample is skipped instead of poisoning the sums and the minimum and maximum
+    RollingWindow gappy(RollingStatistics::DAY);
+    gappy.push(0, 5);
+    gappy.push(10, std::numeric_limits<float>::quiet_NaN());
+    CHECK(gappy.getCount() == 1 && gappy.getMean() == 5 && gappy.getMax() == 5);
+    gappy.push(20, 6);
+    CHECK(gappy.getCount() == 2 && gappy.getMean() == 5.5f && gappy.getMin() == 5 && gappy.getMax() == 6);
+    gappy.push(200, 7);
+    CHECK(gappy.getCount() == 3 && gappy.getMean() == 6 && gappy.getMax() == 7);
+    gappy.push(200 + RollingStatistics::DAY, 8);
+    CHECK(gappy.getCount() == 1 && gappy.getMean() == 8 && gappy.getVariance() == 0 && gappy.getMin() == 8);
+
+    // Rolling statistics follow the timestamps, so loading April before March gives the same series
+    std::vector<WindTempSolar> records = makeRecordsWithGaps(13);
+    size_t april = 0;
+    while (april < records.size() && records[april].getDate().getMonth() == 3) ++april;
+    Station ordered(0, "ordered");
+    Station swapped(1, "swapped");
+    for (size_t i = 0; i < records.size(); ++i) ordered.add(records[i]);
+    for (size_t i = april; i < records.size(); ++i) swapped.add(records[i]);
+    for (size_t i = 0; i < april; ++i) swapped.add(records[i]);
+    const long long lengthArray[] = { RollingStatistics::HOUR, RollingStatistics::DAY };
+    std::vector<long long> lengths(lengthArray, lengthArray + 2);
+    std::vector<std::vector<RollingPoint> > expected = ordered.getCalculator().calculateRollingStatistics("temperature", lengths);
+    std::vector<std::vector<RollingPoint> > actual = swapped.getCalculator().calculateRollingStatistics("temperature", lengths);
+    CHECK(expected.size() == 2 && actual.size() == 2);
+    for (size_t w = 0; w < expected.size() && w < actual.size(); ++w) {
+        CHECK(expected[w].size() == records.size() && actual[w].size() == records.size());
+        int mismatches = 0;
+        for (size_t i = 0; i < expected[w].size() && i < actual[w].size(); ++i) {
+            const RollingPoint& a = actual[w][i];
+            const RollingPoint& e = expected[w][i];
+            if (a.timestamp != e.timestamp || a.count != e.count || !sameBits(a.mean, e.mean) || !sameBits(a.variance, e.variance)
+                || !sameBits(a.min, e.min) || !sameBits(a.max, e.max)) {
+                ++mismatches;
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+}
+
+std::vector<WindTempSolar> visited;
+
+// Collects the records of a traversal
+void collect(WindTempSolar record) {
+    visited.push_back(record);
+}
+
+// The store visits the same distinct records in the same order as a tree built by insertion
+void testOrderedTraversal() {
+    Random random(19);
+    RecordStore store;
+    Bst<WindTempSolar> tree;
+    long long start = Date(1, 1, 2015).toDayNumber() * 24 * 60;
+    for (int i = 0; i < 20000; ++i) {
+        // Coarse values give many records that compare equal
+        WindTempSolar record = recordAt(start + i * 10, (float)(int)(random.uniform() * 20), (float)(int)(random.uniform() * 10), (float)(int)(random.uniform() * 5) * 100);
+        store.add(record);
+        tree.insert(record);
+    }
+
+    visited.clear();
+    tree.inOrderTraversal(collect);
+    std::vector<WindTempSolar> expected = visited;
+    visited.clear();
+    store.orderedTraversal(collect);
+
+    CHECK(visited.size() == expected.size());
+    CHECK(expected.size() < 20000);
+    int mismatches = 0;
+    for (size_t i = 0; i < visited.size() && i < expected.size(); ++i) {
+        if (visited[i].getTimestamp() != expected[i].getTimestamp()) ++mismatches;
+        for (int f = 0; f < WindTempSolar::FIELD_COUNT; ++f) {
+            if (!sameBits(visited[i].getValue(f), expected[i].getValue(f))) ++mismatches;
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+// Exact percentiles match a sorted copy, and t-digest percentiles stay within a small rank error
+void testPercentiles() {
+    Random random(23);
+    std::vector<float> values;
+    for (int i = 0; i < 50000; ++i) {
+        // A skewed distribution, like wind speeds
+        values.push_back((float)(-10 * std::log(1 - random.uniform())));
+    }
+    std::vector<float> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+
+    TDigest digest;
+    for (size_t i = 0; i < values.size(); ++i) digest.add(values[i]);
+
+    const float percentiles[] = { 0, 1, 5, 25, 50, 75, 95, 99, 100 };
+    for (size_t p = 0; p < sizeof(percentiles) / sizeof(percentiles[0]); ++p) {
+        double position = percentiles[p] / 100.0 * (sorted.size() - 1);
+        size_t lower = (size_t)position;
+        double fraction = position - lower;
+        double expected = sorted[lower] + (lower + 1 < sorted.size() ? fraction * (sorted[lower + 1] - sorted[lower]) : 0);
+        std::vector<float> copy = values;
+        CHECK(near(Percentile::calculatePercentile(copy, percentiles[p]), expected, 1e-5));
+
+        // The rank of the approximate value must be within 1% of the requested rank (0.2% in the tails)
+        float approximate = digest.getPercentile(percentiles[p]);
+        double below = (double)(std::lower_bound(sorted.begin(), sorted.end(), approximate) - sorted.begin()) / sorted.size();
+        double atOrBelow = (double)(std::upper_bound(sorted.begin(), sorted.end(), approximate) - sorted.begin()) / sorted.size();
+        double tolerance = (percentiles[p] <= 1 || percentiles[p] >= 99) ? 0.002 : 0.01;
+        CHECK(percentiles[p] / 100.0 >= below - tolerance && percentiles[p] / 100.0 <= atOrBelow + tolerance);
+    }
+
+    std::vector<float> none;
+    CHECK(Percentile::calculatePercentile(none, 50) == 0);
+    std::vector<float> deviations;
+    deviations.push_back(1);
+    deviations.push_back(2);
+    deviations.push_back(3);
+    deviations.push_back(4);
+    deviations.push_back(100);
+    CHECK(Percentile::calculateMedianAbsoluteDeviation(deviations) == 1);
+}
+
+// Report lines expand into one query per period, and malformed lines are rejected with a message
+void testBatchReport() {
+    BatchReport report;
+    std::string error;
+    CHECK(report.addReport("mean wind_speed 3/2015", error));
+    CHECK(report.addReport("stdev temperature 2015", error));
+    CHECK(report.addReport("p95 wind_speed 2014-2015", error));
+    CHECK(report.addReport("correlation wind_speed temperature 6", error));
+    CHECK(report.addReport("total solar_radiation 1/2015-6/2015", error));
+    CHECK(report.addReport("mean wind_speed daily:2/2016", error));
+    CHECK(report.addReport("count temperature hourly:1/3/2015", error));
+    CHECK(report.getQueries().size() == 1 + 12 + 24 + 1 + 1 + 29 + 24);
+
+    const QuerySpec& percentile = report.getQueries()[13];
+    CHECK(percentile.metric == QuerySpec::PERCENTILE && percentile.percentile == 95 && percentile.month == 1 && percentile.year == 2014);
+    const QuerySpec& range = report.getQueries()[1 + 12 + 24 + 1];
+    CHECK(range.isRange() && range.month == 1 && range.endMonth == 6 && range.endYear == 2015);
+    CHECK(report.getQueries()[1 + 12 + 24 + 2].isWindow());
+
+    const char* invalid[] = {
+        "median wind_speed 3/2015",             // Unknown metric
+        "mean humidity 3/2015",                 // Unknown field
+        "mean wind_speed",                      // Missing period
+        "correlation wind_speed 3/2015",        // Missing second field
+        "mean wind_speed 13/2015",              // Month out of range
+        "mean wind_speed 0/2015-3/2015",
+        "mean wind_speed 6/2015-3/2015",        // Range ends before it starts
+        "mean wind_speed 2016-2015",
+        "mean wind_speed hourly:30/2/2015",     // Day does not exist
+        "stdev wind_speed daily:3/2015",        // Metric not kept by the resampled series
+        "mean wind_speed 3/20x5",
+    };
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        error.clear();
+        bool added = report.addReport(invalid[i], error);
+        CHECK(!added && !error.empty());
+        if (added) std::cerr << "  accepted \"" << invalid[i] << "\"" << std::endl;
+    }
+    CHECK(report.getQueries().size() == 1 + 12 + 24 + 1 + 1 + 29 + 24);
+
+    // Each query becomes one CSV line labelled with its period
+    BatchReport single;
+    CHECK(single.addReport("mean wind_speed 3/2015", error));
+    std::ostringstream csv;
+    ReportWriter writer(csv);
+    single.write(writer, std::vector<float>(1, 12.5f), "all");
+    writer.finish();
+    CHECK(csv.str().find("all,3/2015,mean,wind_speed,12.5") != std::string::npos);
+}
+}
+
+int main() {
+    testCsvParser();
+    testCubeMatchesMaskedKernels();
+    testTimestampChecks();
+    testCompressedSeriesRoundTrip();
+    testRollingWindow();
+    testOrderedTraversal();
+    testPercentiles();
+    testBatchReport();
+
+    std::cout << checkCount - failureCount << " of " << checkCount << " checks passed" << std::endl;
+    return failureCount == 0 ? 0 : 1;
+}